@@ -0,0 +1,52 @@
+#ifndef __Benchmark_hpp__
+#define __Benchmark_hpp__
+
+/**
+ * \file   Benchmark.hpp
+ * 
+ * \brief Timing of the library on synthetic trades. 
+ *
+ * Every benchmark prints the running times and the differences of
+ * the prices computed by alternative methods. 
+ */
+
+namespace benchmark
+{
+  /** 
+   * Times the construction of Black model on 2000 event times: the
+   * volatility curve fitted once by Data::volatilityFit against the
+   * curve which is fitted again on every evaluation.
+   */
+  void construction();
+
+  /** 
+   * Times Bermudan swaptions and callable bonds in Hull and White
+   * model: one backward induction for a book of 1000 trades against
+   * one backward induction for every trade.
+   */
+  void bermudan();
+
+  /** 
+   * Times a book of 500 American puts in Black model: one backward
+   * sweep of the portfolio against one backward induction for every
+   * trade.
+   */
+  void portfolio();
+
+  /** 
+   * Times a ladder of 40 American puts in Black model: one strip of
+   * slices against one backward induction for every strike.
+   */
+  void strip();
+
+  /** 
+   * Times daily monitored barrier options in Black model: daily event
+   * times against weekly event times with the continuity correction
+   * and the rollback of knock-out payoffs between event times. The
+   * errors are measured against daily event times with a higher
+   * quality of the model.
+   */
+  void barrier();
+}
+
+#endif // of __Benchmark_hpp__
@@ -0,0 +1,217 @@
+/*-------------------------------------------------------------------------------
+  Description	: timing of daily monitored barrier options in Black model
+  with daily event times and with weekly event times
+  --------------------------------------------------------------------------------*/
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "Benchmark/Benchmark.hpp"
+#include "cfl/BlackModel.hpp"
+#include "cfl/BlackAnalytic.hpp"
+
+using namespace cfl;
+using namespace std;
+
+namespace benchmarkBarrier
+{
+  const double c_dSpot = 100.;
+  const double c_dYield = 0.05;
+  const double c_dDividend = 0.02;
+  const double c_dSigma = 0.2;
+  const double c_dInitialTime = 0.;
+  const double c_dQuality = 200;
+  //the quality of the daily reference prices
+  const double c_dReferenceQuality = 1000;
+  const double c_dInterval = 0.2;
+  const double c_dDay = 1./252.;
+  //the options mature in 25 weeks
+  const unsigned c_iDays = 125;
+  const unsigned c_iWeek = 5;
+  const double c_dNotional = 100.;
+  const double c_dLowerBarrier = 85.;
+  const double c_dUpperBarrier = 120.;
+  const double c_dStrike = 100.;
+  const double c_dInfinity = std::numeric_limits<double>::infinity();
+
+  //the times after the initial time with the step of iDays days
+  vector<double> times(unsigned iDays)
+  {
+    vector<double> uTimes(c_iDays/iDays);
+    for (unsigned iI=0; iI<uTimes.size(); iI++) {
+      uTimes[iI] = c_dInitialTime + (iI+1)*iDays*c_dDay;
+    }
+    return uTimes;
+  }
+
+  double seconds(const chrono::steady_clock::time_point & rStart)
+  {
+    return chrono::duration<double>(chrono::steady_clock::now() - rStart).count();
+  }
+
+  //the event times of the model are rTimes; if bContinuous is true,
+  //then the barriers are monitored continuously between the event
+  //times, otherwise only at the event times
+  class Pricer
+  {
+  public:
+    Pricer(const vector<double> & rTimes, bool bContinuous, AssetModel & rModel)
+      :m_bContinuous(bContinuous), m_rModel(rModel)
+    {
+      vector<double> uEventTimes(rTimes);
+      uEventTimes.insert(uEventTimes.begin(), rModel.initialTime());
+      rModel.assignEventTimes(uEventTimes);
+    }
+
+    //the barrier monitored daily as it is used by the pricer
+    double barrier(double dBarrier, bool bLower) const
+    {
+      return m_bContinuous ?
+	Black::continuousBarrier(dBarrier, bLower, c_dSigma, c_dDay) : dBarrier;
+    }
+
+    //rolls back rOption from iTime to iTime-1; the option is knocked
+    //out if the spot leaves the interval (dLower, dUpper)
+    void rollback(Slice & rOption, unsigned iTime, double dLower, double dUpper) const
+    {
+      if (m_bContinuous) {
+	rOption = cfl::rollback(rOption, iTime-1, m_rModel.spot(iTime-1),
+				m_rModel.spot(iTime), dLower, dUpper);
+      }
+      else {
+	Slice uSpot = m_rModel.spot(iTime);
+	rOption *= indicator(uSpot, dLower) - indicator(uSpot, dUpper);
+	rOption.rollback(iTime-1);
+      }
+    }
+
+    const AssetModel & model() const { return m_rModel; }
+
+  private:
+    bool m_bContinuous;
+    AssetModel & m_rModel;
+  };
+
+  //pays c_dNotional at maturity if the spot stays between the barriers
+  MultiFunction barrierUpOrDownAndOut(const Pricer & rPricer)
+  {
+    double dLower = rPricer.barrier(c_dLowerBarrier, true);
+    double dUpper = rPricer.barrier(c_dUpperBarrier, false);
+    int iTime = rPricer.model().eventTimes().size()-1;
+    Slice uOption = rPricer.model().cash(iTime, c_dNotional);
+    while (iTime > 0) {
+      rPricer.rollback(uOption, iTime, dLower, dUpper);
+      iTime--;
+    }
+    return interpolate(uOption);
+  }
+
+  //American call with weekly exercise times which is knocked out
+  //when the spot goes below the lower barrier
+  MultiFunction downAndOutAmericanCall(const Pricer & rPricer)
+  {
+    double dLower = rPricer.barrier(c_dLowerBarrier, true);
+    vector<double> uExerciseTimes = times(c_iWeek);
+    const vector<double> & rEventTimes = rPricer.model().eventTimes();
+    int iTime = rEventTimes.size()-1;
+    Slice uOption = rPricer.model().cash(iTime, 0.);
+    while (iTime > 0) {
+      if (binary_search(uExerciseTimes.begin(), uExerciseTimes.end(),
+			rEventTimes[iTime])) {
+	uOption = max(uOption, rPricer.model().spot(iTime) - c_dStrike);
+      }
+      rPricer.rollback(uOption, iTime, dLower, c_dInfinity);
+      iTime--;
+    }
+    return interpolate(uOption);
+  }
+
+  //pays c_dNotional at the first weekly payment time after the spot
+  //goes below the lower barrier; the payment times do not depend on
+  //the event times of the model
+  MultiFunction downAndRebate(const Pricer & rPricer)
+  {
+    double dLower = rPricer.barrier(c_dLowerBarrier, true);
+    vector<double> uPaymentTimes = times(c_iWeek);
+    const vector<double> & rEventTimes = rPricer.model().eventTimes();
+    int iTime = rEventTimes.size()-1;
+    //uRebate is the value of the next payment and uOption is the
+    //value of the option minus uRebate
+    Slice uRebate = rPricer.model().cash(iTime, c_dNotional);
+    Slice uOption = rPricer.model().cash(iTime, 0.) - uRebate;
+    while (iTime > 0) {
+      rPricer.rollback(uOption, iTime, dLower, c_dInfinity);
+      uRebate.rollback(iTime-1);
+      iTime--;
+      if ((iTime > 0) && binary_search(uPaymentTimes.begin(), uPaymentTimes.end(),
+				       rEventTimes[iTime])) {
+	uOption += uRebate;
+	uRebate = rPricer.model().cash(iTime, c_dNotional);
+	uOption -= uRebate;
+      }
+    }
+    uOption += uRebate;
+    return interpolate(uOption);
+  }
+
+  //the relative difference with the reference price in percents
+  double error(double dPrice, double dReference)
+  {
+    return 100.*(dPrice - dReference)/dReference;
+  }
+
+  void report(const char * pName, MultiFunction (*f)(const Pricer &),
+	      AssetModel & rModel, AssetModel & rReferenceModel)
+  {
+    valarray<double> uX(0., 1);
+    vector<double> uDaily = times(1);
+    vector<double> uWeekly = times(c_iWeek);
+
+    double dReference = f(Pricer(uDaily, false, rReferenceModel))(uX);
+
+    chrono::steady_clock::time_point uStart = chrono::steady_clock::now();
+    double dDaily = f(Pricer(uDaily, false, rModel))(uX);
+    double dDailyTime = seconds(uStart);
+
+    uStart = chrono::steady_clock::now();
+    double dWeekly = f(Pricer(uWeekly, false, rModel))(uX);
+    double dWeeklyTime = seconds(uStart);
+
+    uStart = chrono::steady_clock::now();
+    double dCorrected = f(Pricer(uWeekly, true, rModel))(uX);
+    double dCorrectedTime = seconds(uStart);
+
+    cout << pName << endl;
+    cout << "reference, daily event times with quality " << c_dReferenceQuality
+	 << ": price = " << dReference << endl;
+    cout << "daily event times: price = " << dDaily
+	 << ", error = " << error(dDaily, dReference) << "%"
+	 << ", time = " << dDailyTime << " sec" << endl;
+    cout << "weekly event times: price = " << dWeekly
+	 << ", error = " << error(dWeekly, dReference) << "%"
+	 << ", time = " << dWeeklyTime << " sec" << endl;
+    cout << "weekly event times with correction: price = " << dCorrected
+	 << ", error = " << error(dCorrected, dReference) << "%"
+	 << ", time = " << dCorrectedTime << " sec" << endl << endl;
+  }
+}
+
+void benchmark::barrier()
+{
+  using namespace benchmarkBarrier;
+
+  Function uDiscount = cfl::Data::discount(c_dYield, c_dInitialTime);
+  Function uForward = cfl::Data::forward(c_dSpot, c_dDividend, uDiscount, c_dInitialTime);
+  Black::Data uData(uDiscount, uForward, c_dSigma, c_dInitialTime);
+  AssetModel uModel = Black::model(uData, c_dInterval, c_dQuality);
+  AssetModel uReferenceModel = Black::model(uData, c_dInterval, c_dReferenceQuality);
+
+  cout << "DAILY MONITORED BARRIERS IN BLACK MODEL" << endl;
+  cout << "number of days = " << c_iDays << endl;
+  cout << "quality = " << c_dQuality << endl << endl;
+
+  report("double barrier knock-out", barrierUpOrDownAndOut, uModel, uReferenceModel);
+  report("down-and-out American call", downAndOutAmericanCall, uModel, uReferenceModel);
+  report("down-and-rebate", downAndRebate, uModel, uReferenceModel);
+}
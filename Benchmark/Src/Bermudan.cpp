@@ -0,0 +1,109 @@
+/*-------------------------------------------------------------------------------
+  Description	: timing of Bermudan swaptions and callable bonds in Hull and 
+  White model for a synthetic book of 1000 trades
+  --------------------------------------------------------------------------------*/
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include "Benchmark/Benchmark.hpp"
+#include "cfl/Bermudan.hpp"
+#include "cfl/HullWhiteModel.hpp"
+#include "cfl/HullWhiteAnalytic.hpp"
+
+using namespace cfl;
+using namespace std;
+
+namespace benchmarkBermudan
+{
+  const double c_dYield = 0.07;
+  const double c_dSigma = 0.02;
+  const double c_dLambda = 0.05;
+  const double c_dInitialTime = 0.;
+  const double c_dQuality = 200;
+  const double c_dInterval = 0.2;
+  const double c_dPeriod = 0.25;
+  const double c_dNotional = 1000.;
+  //quarterly exercise times over 5 years
+  const unsigned c_iExerciseTimes = 20;
+  //half of the book are swaptions and half are callable bonds
+  const unsigned c_iTrades = 1000;
+
+  double seconds(const chrono::steady_clock::time_point & rStart)
+  {
+    return chrono::duration<double>(chrono::steady_clock::now() - rStart).count();
+  }
+
+  //the largest difference between the prices at the short rate c_dYield
+  double difference(const vector<MultiFunction> & rPrice1, 
+		    const vector<MultiFunction> & rPrice2)
+  {
+    valarray<double> uX(0., 1);
+    double dDiff = 0.;
+    for (unsigned iI=0; iI<rPrice1.size(); iI++) {
+      dDiff = std::max(dDiff, std::abs(rPrice1[iI](uX) - rPrice2[iI](uX)));
+    }
+    return dDiff;
+  }
+}
+
+void benchmark::bermudan()
+{
+  using namespace benchmarkBermudan;
+
+  Function uDiscount = cfl::Data::discount(c_dYield, c_dInitialTime);
+  HullWhite::Data uData(uDiscount, c_dSigma, c_dLambda, c_dInitialTime);
+  InterestRateModel uModel = HullWhite::model(uData, c_dInterval, c_dQuality);
+
+  vector<double> uExerciseTimes(c_iExerciseTimes);
+  for (unsigned iI=0; iI<uExerciseTimes.size(); iI++) {
+    uExerciseTimes[iI] = c_dInitialTime + (iI+1)*c_dPeriod;
+  }
+
+  //synthetic book: maturities from 5 to 10 years, rates around c_dYield
+  vector<cfl::Data::Swap> uSwaps(c_iTrades/2);
+  vector<cfl::Data::CashFlow> uBonds(c_iTrades/2);
+  for (unsigned iI=0; iI<uSwaps.size(); iI++) {
+    cfl::Data::CashFlow uFlow;
+    uFlow.notional = c_dNotional;
+    uFlow.period = c_dPeriod;
+    uFlow.rate = c_dYield*(0.8 + 0.4*iI/uSwaps.size());
+    uFlow.numberOfPayments = c_iExerciseTimes + (iI % 21);
+    uSwaps[iI] = cfl::Data::Swap(uFlow, iI % 2 == 0);
+    uBonds[iI] = uFlow;
+  }
+
+  cout << "BERMUDAN SWAPTIONS AND CALLABLE BONDS IN HULL AND WHITE MODEL" << endl;
+  cout << "number of trades = " << c_iTrades << endl;
+  cout << "number of exercise times = " << c_iExerciseTimes << endl << endl;
+
+  chrono::steady_clock::time_point uStart = chrono::steady_clock::now();
+  vector<MultiFunction> uBookSwaptions = 
+    Bermudan::swaption(uSwaps, uExerciseTimes, uModel);
+  vector<MultiFunction> uBookBonds = 
+    Bermudan::callableBond(uBonds, uExerciseTimes, uModel);
+  double dBook = seconds(uStart);
+
+  uStart = chrono::steady_clock::now();
+  vector<MultiFunction> uSwaptions, uCallableBonds;
+  for (unsigned iI=0; iI<uSwaps.size(); iI++) {
+    uSwaptions.push_back(Bermudan::swaption(uSwaps[iI], uExerciseTimes, uModel));
+    uCallableBonds.push_back(Bermudan::callableBond(uBonds[iI], uExerciseTimes, uModel));
+  }
+  double dOneByOne = seconds(uStart);
+
+  cout << "one backward induction for the book: " << dBook << " sec" << endl;
+  cout << "one backward induction for every trade: " << dOneByOne << " sec" << endl;
+  cout << "largest difference of prices: " 
+       << std::max(difference(uBookSwaptions, uSwaptions), 
+		   difference(uBookBonds, uCallableBonds)) << endl << endl;
+
+  //with one exercise time the swaption is European
+  const cfl::Data::Swap & rAtTheMoney = uSwaps[uSwaps.size()/2];
+  vector<double> uMaturity(1, uExerciseTimes.front());
+  MultiFunction uEuropean = Bermudan::swaption(rAtTheMoney, uMaturity, uModel);
+  MultiFunction uExact = HullWhite::swaption(uData, rAtTheMoney, uMaturity.front());
+  cout << "European swaption, closed form price: " 
+       << uExact(valarray<double>(0., 1)) << endl;
+  cout << "European swaption, largest difference with closed form: " 
+       << HullWhite::validate(uExact, uEuropean, c_dInterval) << endl << endl;
+}
@@ -0,0 +1,133 @@
+/*-------------------------------------------------------------------------------
+  Description	: timing of the construction of Black model with the
+  volatility curve fitted once against the curve fitted on every call
+  --------------------------------------------------------------------------------*/
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include "Benchmark/Benchmark.hpp"
+#include "cfl/BlackModel.hpp"
+
+using namespace cfl;
+using namespace std;
+
+namespace benchmarkConstruction
+{
+  const double c_dSpot = 100.;
+  const double c_dYield = 0.05;
+  const double c_dDividend = 0.02;
+  const double c_dLambda = 0.05;
+  const double c_dInitialTime = 0.;
+  const double c_dQuality = 200;
+  const double c_dInterval = 0.2;
+  //the quotes of volatilities are given for 40 maturities
+  const unsigned c_iQuotes = 40;
+  const unsigned c_iEventTimes = 2000;
+  const double c_dMaturity = 10.;
+  const unsigned c_iRuns = 10;
+
+  double seconds(const chrono::steady_clock::time_point & rStart)
+  {
+    return chrono::duration<double>(chrono::steady_clock::now() - rStart).count();
+  }
+
+  //the fit as it was done before Data::volatilityFit: the shape
+  //function is rebuilt and the least square fit is solved again for
+  //every evaluation
+  class Refit: public IFunction
+  {
+  public:
+    Refit(const vector<double> & rTimes, const vector<double> & rVolatility)
+      :m_uTimes(rTimes), m_uVolatility(rVolatility)
+    {}
+
+    double operator()(double dX) const
+    {
+      Function uShape = cfl::Data::volatility(1., -c_dLambda, c_dInitialTime);
+      vector<double> uA(m_uTimes.size());
+      transform(m_uTimes.begin(), m_uTimes.end(), uA.begin(), uShape);
+      double dCov = inner_product(m_uVolatility.begin(), m_uVolatility.end(),
+				  uA.begin(), 0.);
+      double dVar = inner_product(uA.begin(), uA.end(), uA.begin(), 0.);
+      return dCov/dVar*uShape(dX);
+    }
+
+    bool belongs(double dX) const
+    {
+      return dX >= c_dInitialTime;
+    }
+
+  private:
+    vector<double> m_uTimes, m_uVolatility;
+  };
+
+  //the time of one evaluation of the variance curve at the event
+  //times rEventTimes as it is done by Black model
+  double varianceTime(const Function & rVolatility, const vector<double> & rEventTimes)
+  {
+    vector<double> uVar(rEventTimes.size());
+    chrono::steady_clock::time_point uStart = chrono::steady_clock::now();
+    for (unsigned iR=0; iR<c_iRuns; iR++) {
+      cfl::pow(rVolatility, 2).evaluate(rEventTimes.data(), uVar.data(), uVar.size());
+    }
+    return seconds(uStart)/c_iRuns;
+  }
+
+  //the time of one construction of Black model with the event times
+  //rEventTimes
+  double buildTime(const Function & rVolatility, const vector<double> & rEventTimes)
+  {
+    Function uDiscount = cfl::Data::discount(c_dYield, c_dInitialTime);
+    Function uForward = cfl::Data::forward(c_dSpot, c_dDividend, uDiscount,
+					   c_dInitialTime);
+    Black::Data uData(uDiscount, uForward, rVolatility, c_dInitialTime);
+    chrono::steady_clock::time_point uStart = chrono::steady_clock::now();
+    for (unsigned iR=0; iR<c_iRuns; iR++) {
+      AssetModel uModel = Black::model(uData, c_dInterval, c_dQuality);
+      uModel.assignEventTimes(rEventTimes);
+    }
+    return seconds(uStart)/c_iRuns;
+  }
+}
+
+void benchmark::construction()
+{
+  using namespace benchmarkConstruction;
+
+  vector<double> uTimes(c_iQuotes), uVolatility(c_iQuotes);
+  for (unsigned iI=0; iI<uTimes.size(); iI++) {
+    uTimes[iI] = c_dInitialTime + (iI+1)*c_dMaturity/c_iQuotes;
+    uVolatility[iI] = 0.2 + 0.05*std::sin(uTimes[iI]);
+  }
+  vector<double> uEventTimes(c_iEventTimes);
+  for (unsigned iI=0; iI<uEventTimes.size(); iI++) {
+    uEventTimes[iI] = c_dInitialTime + iI*c_dMaturity/c_iEventTimes;
+  }
+
+  Function uFit = cfl::Data::volatilityFit(uTimes, uVolatility, c_dLambda,
+					   c_dInitialTime);
+  Function uRefit(new benchmarkConstruction::Refit(uTimes, uVolatility));
+
+  cout << "CONSTRUCTION OF BLACK MODEL WITH FITTED VOLATILITY" << endl;
+  cout << "number of quotes = " << c_iQuotes << endl;
+  cout << "number of event times = " << c_iEventTimes << endl << endl;
+
+  double dFitVar = varianceTime(uFit, uEventTimes);
+  double dRefitVar = varianceTime(uRefit, uEventTimes);
+  double dFit = buildTime(uFit, uEventTimes);
+  double dRefit = buildTime(uRefit, uEventTimes);
+  double dDiff = 0.;
+  for (unsigned iI=0; iI<uEventTimes.size(); iI++) {
+    dDiff = std::max(dDiff, std::abs(uFit(uEventTimes[iI]) - uRefit(uEventTimes[iI])));
+  }
+
+  cout << "variance at event times, volatility fitted once: " 
+       << dFitVar << " sec" << endl;
+  cout << "variance at event times, volatility fitted on every call: " 
+       << dRefitVar << " sec" << endl;
+  cout << "model, volatility fitted once: " << dFit << " sec" << endl;
+  cout << "model, volatility fitted on every call: " << dRefit << " sec" << endl;
+  cout << "largest difference of volatilities: " << dDiff << endl << endl;
+}
@@ -0,0 +1,10 @@
+#include "Benchmark/Benchmark.hpp"
+
+int main()
+{
+  benchmark::construction();
+  benchmark::bermudan();
+  benchmark::portfolio();
+  benchmark::strip();
+  benchmark::barrier();
+}
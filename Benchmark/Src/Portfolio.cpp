@@ -0,0 +1,116 @@
+/*-------------------------------------------------------------------------------
+  Description	: timing of a book of 500 American puts in Black model
+  priced in one backward sweep and one by one
+  --------------------------------------------------------------------------------*/
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include "Benchmark/Benchmark.hpp"
+#include "cfl/BlackModel.hpp"
+#include "cfl/Portfolio.hpp"
+
+using namespace cfl;
+using namespace std;
+
+namespace benchmarkPortfolio
+{
+  const double c_dSpot = 100.;
+  const double c_dYield = 0.05;
+  const double c_dDividend = 0.02;
+  const double c_dSigma = 0.2;
+  const double c_dInitialTime = 0.;
+  const double c_dQuality = 200;
+  const double c_dInterval = 0.2;
+  const double c_dPeriod = 1./12.;
+  //monthly exercise times; the maturities are from 1 to 12 months
+  const unsigned c_iPeriods = 12;
+  const unsigned c_iTrades = 500;
+
+  double seconds(const chrono::steady_clock::time_point & rStart)
+  {
+    return chrono::duration<double>(chrono::steady_clock::now() - rStart).count();
+  }
+
+  //the exercise times of the put with iPeriods monthly exercises
+  vector<double> exerciseTimes(unsigned iPeriods)
+  {
+    vector<double> uTimes(iPeriods);
+    for (unsigned iI=0; iI<uTimes.size(); iI++) {
+      uTimes[iI] = c_dInitialTime + (iI+1)*c_dPeriod;
+    }
+    return uTimes;
+  }
+
+  //the price of the American put in its own backward induction
+  double americanPut(double dStrike, unsigned iPeriods, AssetModel & rModel)
+  {
+    vector<double> uEventTimes = exerciseTimes(iPeriods);
+    uEventTimes.insert(uEventTimes.begin(), rModel.initialTime());
+    rModel.assignEventTimes(uEventTimes);
+    int iTime = uEventTimes.size()-1;
+    Slice uOption = rModel.cash(iTime, 0.);
+    while (iTime > 0) {
+      uOption = max(uOption, dStrike - rModel.spot(iTime));
+      iTime--;
+      uOption.rollback(iTime);
+    }
+    return atOrigin(uOption);
+  }
+
+  //the American put as a trade in a portfolio priced on rModel
+  Trade americanPutTrade(double dStrike, unsigned iPeriods, const AssetModel & rModel)
+  {
+    return toTrade(exerciseTimes(iPeriods), [dStrike, &rModel](Slice & rOption,
+							      unsigned iTime) {
+		     rOption = max(rOption, dStrike - rModel.spot(iTime));
+		   });
+  }
+}
+
+void benchmark::portfolio()
+{
+  using namespace benchmarkPortfolio;
+
+  Function uDiscount = cfl::Data::discount(c_dYield, c_dInitialTime);
+  Function uForward = cfl::Data::forward(c_dSpot, c_dDividend, uDiscount, c_dInitialTime);
+  Black::Data uData(uDiscount, uForward, c_dSigma, c_dInitialTime);
+  AssetModel uModel = Black::model(uData, c_dInterval, c_dQuality);
+
+  //synthetic book: strikes from 80 to 120 and maturities from 1 to 12 months
+  vector<double> uStrikes(c_iTrades);
+  vector<unsigned> uPeriods(c_iTrades);
+  vector<Trade> uBook(c_iTrades);
+  for (unsigned iI=0; iI<c_iTrades; iI++) {
+    uStrikes[iI] = 80. + 40.*iI/c_iTrades;
+    uPeriods[iI] = 1 + iI % c_iPeriods;
+    uBook[iI] = americanPutTrade(uStrikes[iI], uPeriods[iI], uModel);
+  }
+
+  cout << "BOOK OF AMERICAN PUTS IN BLACK MODEL" << endl;
+  cout << "number of trades = " << c_iTrades << endl << endl;
+
+  chrono::steady_clock::time_point uStart = chrono::steady_clock::now();
+  uModel.assignEventTimes(eventTimes(uBook, uModel.initialTime()));
+  vector<Slice> uValues = sweep(uBook, uModel.cash(0, 0.));
+  vector<double> uSweep(c_iTrades);
+  transform(uValues.begin(), uValues.end(), uSweep.begin(),
+	    [](const Slice & rValue) { return atOrigin(rValue); });
+  double dSweep = seconds(uStart);
+
+  uStart = chrono::steady_clock::now();
+  vector<double> uOneByOne(c_iTrades);
+  for (unsigned iI=0; iI<c_iTrades; iI++) {
+    uOneByOne[iI] = americanPut(uStrikes[iI], uPeriods[iI], uModel);
+  }
+  double dOneByOne = seconds(uStart);
+
+  double dDiff = 0.;
+  for (unsigned iI=0; iI<c_iTrades; iI++) {
+    dDiff = std::max(dDiff, std::abs(uSweep[iI] - uOneByOne[iI]));
+  }
+
+  cout << "one backward sweep for the book: " << dSweep << " sec" << endl;
+  cout << "one backward induction for every trade: " << dOneByOne << " sec" << endl;
+  cout << "largest difference of prices: " << dDiff << endl << endl;
+}
@@ -0,0 +1,107 @@
+/*-------------------------------------------------------------------------------
+  Description	: timing of a ladder of 40 American puts in Black model
+  priced as one strip of slices and strike by strike
+  --------------------------------------------------------------------------------*/
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include "Benchmark/Benchmark.hpp"
+#include "cfl/BlackModel.hpp"
+#include "cfl/Strip.hpp"
+
+using namespace cfl;
+using namespace std;
+
+namespace benchmarkStrip
+{
+  const double c_dSpot = 100.;
+  const double c_dYield = 0.05;
+  const double c_dDividend = 0.02;
+  const double c_dSigma = 0.2;
+  const double c_dInitialTime = 0.;
+  const double c_dQuality = 200;
+  const double c_dInterval = 0.2;
+  //weekly exercise times over half a year
+  const unsigned c_iExerciseTimes = 26;
+  const double c_dPeriod = 1./52.;
+  const unsigned c_iStrikes = 40;
+
+  double seconds(const chrono::steady_clock::time_point & rStart)
+  {
+    return chrono::duration<double>(chrono::steady_clock::now() - rStart).count();
+  }
+
+  //the prices of American puts with the strikes rStrikes in one
+  //backward induction of the strip
+  vector<double> americanPuts(const vector<double> & rStrikes, const AssetModel & rModel)
+  {
+    int iTime = rModel.eventTimes().size()-1;
+    Strip uOption(rModel.cash(iTime, 0.), rStrikes.size());
+    while (iTime > 0) {
+      uOption = max(uOption, rStrikes - rModel.spot(iTime));
+      iTime--;
+      uOption.rollback(iTime);
+    }
+    return atOrigin(uOption);
+  }
+
+  //the price of the American put in its own backward induction
+  double americanPut(double dStrike, const AssetModel & rModel)
+  {
+    int iTime = rModel.eventTimes().size()-1;
+    Slice uOption = rModel.cash(iTime, 0.);
+    while (iTime > 0) {
+      uOption = max(uOption, dStrike - rModel.spot(iTime));
+      iTime--;
+      uOption.rollback(iTime);
+    }
+    return atOrigin(uOption);
+  }
+}
+
+void benchmark::strip()
+{
+  using namespace benchmarkStrip;
+
+  Function uDiscount = cfl::Data::discount(c_dYield, c_dInitialTime);
+  Function uForward = cfl::Data::forward(c_dSpot, c_dDividend, uDiscount, c_dInitialTime);
+  Black::Data uData(uDiscount, uForward, c_dSigma, c_dInitialTime);
+  AssetModel uModel = Black::model(uData, c_dInterval, c_dQuality);
+
+  vector<double> uEventTimes(c_iExerciseTimes + 1);
+  for (unsigned iI=0; iI<uEventTimes.size(); iI++) {
+    uEventTimes[iI] = c_dInitialTime + iI*c_dPeriod;
+  }
+  uModel.assignEventTimes(uEventTimes);
+
+  //the ladder of strikes from 80 to 119
+  vector<double> uStrikes(c_iStrikes);
+  for (unsigned iI=0; iI<c_iStrikes; iI++) {
+    uStrikes[iI] = 80. + iI;
+  }
+
+  cout << "LADDER OF STRIKES OF AMERICAN PUTS IN BLACK MODEL" << endl;
+  cout << "number of strikes = " << c_iStrikes << endl;
+  cout << "number of exercise times = " << c_iExerciseTimes << endl << endl;
+
+  chrono::steady_clock::time_point uStart = chrono::steady_clock::now();
+  vector<double> uLadder = americanPuts(uStrikes, uModel);
+  double dLadder = seconds(uStart);
+
+  uStart = chrono::steady_clock::now();
+  vector<double> uOneByOne(c_iStrikes);
+  for (unsigned iI=0; iI<c_iStrikes; iI++) {
+    uOneByOne[iI] = americanPut(uStrikes[iI], uModel);
+  }
+  double dOneByOne = seconds(uStart);
+
+  double dDiff = 0.;
+  for (unsigned iI=0; iI<c_iStrikes; iI++) {
+    dDiff = std::max(dDiff, std::abs(uLadder[iI] - uOneByOne[iI]));
+  }
+
+  cout << "one backward induction for the strip: " << dLadder << " sec" << endl;
+  cout << "one backward induction for every strike: " << dOneByOne << " sec" << endl;
+  cout << "largest difference of prices: " << dDiff << endl << endl;
+}
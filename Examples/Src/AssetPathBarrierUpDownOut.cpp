@@ -8,20 +8,20 @@ class IndUpDownOut: public IResetValues
 public:
   IndUpDownOut(double dLowerBarrier, double dUpperBarrier, 
 	       const AssetModel & rModel)
-    :m_dLowerBarrier(dLowerBarrier), m_dUpperBarrier(dUpperBarrier), 
-     m_rModel(rModel) 
+    :m_uBarriers(2), m_rModel(rModel) 
   {
     ASSERT(dLowerBarrier < dUpperBarrier);
+    m_uBarriers[0] = dLowerBarrier;
+    m_uBarriers[1] = dUpperBarrier;
   }
 		
   Slice resetValues(unsigned iTime, double dBeforeReset) const 
   {
-    return dBeforeReset*indicator(m_rModel.spot(iTime), m_dLowerBarrier)*
-      indicator(m_dUpperBarrier, m_rModel.spot(iTime));
+    std::vector<Slice> uInd = indicator(m_rModel.spot(iTime), m_uBarriers);
+    return dBeforeReset*uInd[0]*(1.-uInd[1]);
   }
 private:
-  double m_dLowerBarrier; 
-  double m_dUpperBarrier;
+  std::vector<double> m_uBarriers;
   const AssetModel & m_rModel;
 };
 
@@ -15,13 +15,17 @@ barrierUpOrDownAndOut(double dNotional, double dLowerBarrier,
   uEventTimes.insert(uEventTimes.begin(), rModel.initialTime());
   rModel.assignEventTimes(uEventTimes);
 	
+  std::vector<double> uBarriers(2);
+  uBarriers[0] = dLowerBarrier;
+  uBarriers[1] = dUpperBarrier;
   int iTime = uEventTimes.size()-1;
   Slice uOption = rModel.cash(iTime, dNotional); 
   while (iTime > 0) {
     //uOption is the value to continue (the value of the option 
     //if no barriers have been crossed before and now)
-    uOption*=indicator(rModel.spot(iTime), dLowerBarrier);
-    uOption*=indicator(dUpperBarrier, rModel.spot(iTime));
+    std::vector<Slice> uInd = indicator(rModel.spot(iTime), uBarriers);
+    uOption*=uInd[0];
+    uOption*=1.-uInd[1];
     iTime--;
     uOption.rollback(iTime);
   }
@@ -7,16 +7,8 @@ cfl::Slice prb::
 couponBond(unsigned iTime, const Data::CashFlow & rBond, 
 	   const InterestRateModel & rModel) 
 {
-  Slice uCashFlow = rModel.cash(iTime, 0.);
-  double dTime = rModel.eventTimes()[iTime];
-  for (unsigned iI=0; iI<rBond.numberOfPayments; iI++) {
-    dTime += rBond.period;
-    uCashFlow += rModel.discount(iTime, dTime);
-  }
-  uCashFlow *= (rBond.rate*rBond.period);
-  uCashFlow += rModel.discount(iTime, dTime);
-  uCashFlow *= rBond.notional;
-  return uCashFlow;
+  Data::Schedule uBond(rBond, rModel.eventTimes()[iTime]);
+  return rModel.value(iTime, uBond);
 }
 	
 cfl::Slice prb::
@@ -46,56 +46,6 @@ namespace chengzhhhw1
         cfl::Function m_rForeignDiscount;
     };
 
-    class forwardFXCouponFunc : public cfl::IFunction
-    {
-    public:
-        forwardFXCouponFunc(const cfl::Data::CashFlow &rBond, const cfl::Function &rDiscount, double dInitialTime, bool bClean)
-        {
-            m_rBond = rBond;
-            m_rDiscount = rDiscount;
-            m_dInitialTime = dInitialTime;
-            m_bClean = bClean;
-        }
-
-        // Dirty Price = sum(q*N*d(ti)/d(t))+N*d(T)/d(t)
-        // Clean Price = Dirty Price - Accured Interest
-        double operator()(double dX) const
-        {
-            double dirtyPrice = 0;
-            std::vector<double> timeFrames;
-            for (int i = 0; i < m_rBond.numberOfPayments + 1; i++)
-            {
-                timeFrames.push_back(m_dInitialTime + i * m_rBond.period);
-            }
-            double ti = *(upper_bound(timeFrames.begin(), timeFrames.end(), dX) - 1); // binary search (Ologn)
-            int iplus1 = static_cast<int>(upper_bound(timeFrames.begin(), timeFrames.end(), dX) - timeFrames.begin());
-            for (int i = iplus1; i < timeFrames.size(); i++)
-            {
-                dirtyPrice += m_rBond.rate * m_rBond.period * m_rBond.notional * m_rDiscount(timeFrames[i]) / m_rDiscount(dX);
-                if (i == timeFrames.size() - 1)
-                    dirtyPrice += m_rBond.notional * m_rDiscount(timeFrames.back()) / m_rDiscount(dX);
-            }
-
-            if (!m_bClean)
-                return dirtyPrice;
-
-            double accuredInterest = m_rBond.rate * (dX - ti) * m_rBond.notional;
-
-            return dirtyPrice - accuredInterest;
-        }
-
-        bool belongs(double dX) const
-        {
-            return m_rDiscount.belongs(dX) && dX >= m_dInitialTime; //dX belongs to the interval [t_0, T]
-        }
-
-    private:
-        cfl::Data::CashFlow m_rBond;
-        cfl::Function m_rDiscount;
-        double m_dInitialTime;
-        bool m_bClean;
-    };
-
     class forwardLogLinearInterpFunc : public cfl::IFunction
     {
     public:
@@ -140,50 +90,6 @@ namespace chengzhhhw1
         std::vector<double> m_DT;
         std::vector<double> r_FP;
     };
-
-    class fitVolBlackModel : public cfl::IFunction
-    {
-    public:
-        fitVolBlackModel(const std::vector<double> &rMaturities, const std::vector<double> &rVolatilities, double dLambda, double dInitialTime)
-        {
-            m_rMaturities = std::vector<double>(rMaturities);
-            m_rVols = std::vector<double>(rVolatilities);
-            m_dLambda = dLambda;
-            m_InitialTime = dInitialTime;
-        }
-
-        void fit()
-        {
-        }
-
-        double operator()(double dX) const
-        {
-            int initialTime = m_InitialTime;
-
-            cfl::Function uVolShape = cfl::sqrt(prb::yieldShapeHullWhite(2 * m_dLambda, m_InitialTime));
-            std::vector<double> uA(m_rMaturities.size());
-            std::transform(m_rMaturities.begin(), m_rMaturities.end(), uA.begin(), uVolShape);
-
-            double dCov =
-                std::inner_product(m_rVols.begin(), m_rVols.end(), uA.begin(), 0.);
-            double dVar = std::inner_product(uA.begin(), uA.end(), uA.begin(), 0.);
-
-            double dA = dCov / dVar;
-
-            return dA * uVolShape(dX);
-        }
-
-        bool belongs(double dX) const
-        {
-            return dX >= m_InitialTime;
-        }
-
-    private:
-        std::vector<double> m_rMaturities;
-        std::vector<double> m_rVols;
-        double m_dLambda;
-        double m_InitialTime;
-    };
 } // namespace chengzhhhw1
 
 cfl::Function prb::forwardFX(double dSpotFX, const cfl::Function &rDomesticDiscount, const cfl::Function &rForeignDiscount)
@@ -194,7 +100,7 @@ cfl::Function prb::forwardFX(double dSpotFX, const cfl::Function &rDomesticDisco
 
 cfl::Function prb::forwardCouponBond(const cfl::Data::CashFlow &rBond, const cfl::Function &rDiscount, double dInitialTime, bool bClean)
 {
-    return cfl::Function(new chengzhhhw1::forwardFXCouponFunc(rBond, rDiscount, dInitialTime, bClean));
+    return cfl::Data::forwardPrice(cfl::Data::Schedule(rBond, dInitialTime), rDiscount, bClean);
 }
 
 cfl::Function prb::forwardLogLinearInterp(double dSpot, const std::vector<double> &rDeliveryTimes, const std::vector<double> &rForwardPrices, double dInitialTime)
@@ -204,7 +110,8 @@ cfl::Function prb::forwardLogLinearInterp(double dSpot, const std::vector<double
 
 cfl::Function prb::volatilityFitBlack(const std::vector<double> &rMaturities, const std::vector<double> &rVolatilities, double dLambda, double dInitialTime)
 {
-    return cfl::Function(new chengzhhhw1::fitVolBlackModel(rMaturities, rVolatilities, dLambda, dInitialTime));
+    // the fit is computed once; the result is the stationary volatility curve in closed form
+    return cfl::Data::volatilityFit(rMaturities, rVolatilities, dLambda, dInitialTime);
 }
 
 /************
@@ -120,7 +120,8 @@ prb::upAndInAmericanPut(double dBarrier,
         }
         if (std::binary_search(rBarrierTimes.begin(),rBarrierTimes.end(), dTime)){
         // uOption *= indicator(rModel.spot(iTime), dLowerBarrier);
-        uOption = cfl::indicator(rModel.spot(iTime), dBarrier) * ameriOption + cfl::indicator(dBarrier, rModel.spot(iTime)) * uOption;
+        cfl::Slice uInd = cfl::indicator(rModel.spot(iTime), dBarrier);
+        uOption = uInd * ameriOption + (1. - uInd) * uOption;
         }
         iTime--;
         ameriOption.rollback(iTime);
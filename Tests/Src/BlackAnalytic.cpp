@@ -0,0 +1,93 @@
+/*-------------------------------------------------------------------------------
+  Description	: checks of the closed-form prices of European options in
+  Black model against the numerical prices on the grid
+  --------------------------------------------------------------------------------*/
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <valarray>
+#include <algorithm>
+#include "Tests/Tests.hpp"
+#include "cfl/BlackModel.hpp"
+#include "cfl/BlackAnalytic.hpp"
+
+using namespace cfl;
+using namespace std;
+
+namespace testsBlackAnalytic
+{
+  const double c_dSpot = 100.;
+  const double c_dYield = 0.05;
+  const double c_dDividend = 0.02;
+  const double c_dSigma = 0.2;
+  const double c_dInitialTime = 0.;
+  const double c_dQuality = 400;
+  const double c_dInterval = 0.2;
+  const double c_dStrike = 105.;
+  const double c_dMaturity = 1.;
+  //the tolerance relative to the price
+  const double c_dTolerance = 2e-4;
+  const std::vector<double> c_uStates = {-0.1, 0., 0.1};
+  const std::vector<Black::European::Payoff> c_uPayoffs = 
+    {Black::European::eCall, Black::European::ePut, Black::European::eStraddle, 
+     Black::European::eDigitalCall, Black::European::eDigitalPut};
+  const char * c_sPayoffs[] = {"call", "put", "straddle", "digital call", "digital put"};
+
+  //the numerical price of rOption at the initial time
+  MultiFunction gridPrice(const Black::European & rOption, AssetModel & rModel)
+  {
+    rModel.assignEventTimes({c_dInitialTime, rOption.maturity});
+    Slice uOption = Black::payoff(rOption, rModel.spot(1));
+    uOption.rollback(0);
+    return interpolate(uOption);
+  }
+
+  //the largest difference between rF and rG at the states c_uStates
+  //relative to max(|rG|, 1e-2)
+  double error(const MultiFunction & rF, const MultiFunction & rG)
+  {
+    double dErr = 0.;
+    for (double dX : c_uStates) {
+      std::valarray<double> uX(dX, 1);
+      double dG = rG(uX);
+      dErr = std::max(dErr, std::abs(rF(uX) - dG)/std::max(std::abs(dG), 1e-2));
+    }
+    return dErr;
+  }
+}
+
+bool tests::blackAnalytic()
+{
+  using namespace testsBlackAnalytic;
+
+  cout << "CLOSED-FORM PRICES IN BLACK MODEL" << endl;
+  Function uDiscount = cfl::Data::discount(c_dYield, c_dInitialTime);
+  Function uForward = cfl::Data::forward(c_dSpot, c_dDividend, uDiscount, c_dInitialTime);
+  Black::Data uData(uDiscount, uForward, c_dSigma, c_dInitialTime);
+  AssetModel uModel = Black::model(uData, c_dInterval, c_dQuality);
+  cout << "tolerance relative to price = " << c_dTolerance << endl;
+
+  Black::European uCall = {Black::European::eCall, c_dStrike, c_dMaturity};
+  MultiFunction uGridCall = gridPrice(uCall, uModel);
+  MultiFunction uExactCall = Black::price(uData, uCall);
+  bool bPassed = true;
+  for (unsigned iP=0; iP<c_uPayoffs.size(); iP++) {
+    Black::European uOption = {c_uPayoffs[iP], c_dStrike, c_dMaturity};
+    MultiFunction uExact = Black::price(uData, uOption);
+    MultiFunction uGrid = gridPrice(uOption, uModel);
+    //the call is the control variate for all payoffs
+    MultiFunction uControl = Black::controlVariate(uGrid, uGridCall, uData, uCall);
+    MultiFunction uSum = uGrid - uGridCall + uExactCall;
+    double dGrid = error(uGrid, uExact);
+    double dControl = error(uControl, uExact);
+    double dSum = error(uControl, uSum);
+    cout << c_sPayoffs[iP] << ": closed form = " << uExact(std::valarray<double>(0., 1))
+	 << ", grid = " << uGrid(std::valarray<double>(0., 1)) << endl;
+    cout << "  error of grid = " << dGrid << ", error with control variate = " 
+	 << dControl << endl;
+    bPassed = bPassed && (dGrid <= c_dTolerance) && (dControl <= c_dTolerance) 
+      && (dSum <= 1e-12);
+  }
+  cout << endl;
+  return bPassed;
+}
@@ -0,0 +1,133 @@
+/*-------------------------------------------------------------------------------
+  Description	: checks of the par residuals and of the updates of
+  cfl::Bootstrap
+  --------------------------------------------------------------------------------*/
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "Tests/Tests.hpp"
+#include "cfl/Bootstrap.hpp"
+
+using namespace cfl;
+using namespace std;
+
+namespace testsBootstrap
+{
+  const double c_dInitialTime = 0.;
+  const double c_dTolerance = 1e-9;
+  const std::vector<double> c_uDepositTimes = {0.25, 0.5};
+  const double c_dFraStart = 0.5;
+  const double c_dFraPeriod = 0.5;
+  const double c_dSwapPeriod = 1.;
+  const std::vector<unsigned> c_uSwapPayments = {2, 3, 5};
+
+  //the quotes in the order in which the instruments are added:
+  //deposits, forward rate agreement and swaps
+  std::vector<double> quotes()
+  {
+    return {0.03, 0.031, 0.033, 0.035, 0.037, 0.04};
+  }
+
+  Data::Swap swap(unsigned iPayments, double dRate)
+  {
+    Data::Swap uSwap;
+    uSwap.notional = 1.;
+    uSwap.rate = dRate;
+    uSwap.period = c_dSwapPeriod;
+    uSwap.numberOfPayments = iPayments;
+    uSwap.payFloat = true;
+    return uSwap;
+  }
+
+  //the largest par residual of the instruments with the quotes
+  //rQuotes for the published curve
+  double residual(const Bootstrap & rBootstrap, const std::vector<double> & rQuotes)
+  {
+    const Function & rD = rBootstrap.curve()->discount;
+    std::vector<double> uR;
+    unsigned iQ = 0;
+    for (double dT : c_uDepositTimes) {
+      uR.push_back(rD(dT)*(1. + rQuotes[iQ++]*(dT - c_dInitialTime)) - 1.);
+    }
+    double dFraEnd = c_dFraStart + c_dFraPeriod;
+    uR.push_back(rD(dFraEnd)*(1. + rQuotes[iQ++]*c_dFraPeriod)/rD(c_dFraStart) - 1.);
+    for (unsigned iN : c_uSwapPayments) {
+      double dFixed = 0.;
+      for (unsigned iK=1; iK<=iN; iK++) {
+	dFixed += rD(c_dInitialTime + iK*c_dSwapPeriod);
+      }
+      double dMaturity = c_dInitialTime + iN*c_dSwapPeriod;
+      uR.push_back(rQuotes[iQ++]*c_dSwapPeriod*dFixed + rD(dMaturity) - 1.);
+    }
+    double dErr = 0.;
+    for (double dR : uR) {
+      dErr = std::max(dErr, std::abs(dR));
+    }
+    return dErr;
+  }
+}
+
+bool tests::bootstrap()
+{
+  using namespace testsBootstrap;
+
+  cout << "BOOTSTRAP" << endl;
+  std::vector<double> uQuotes = quotes();
+  Bootstrap uBootstrap(c_dInitialTime);
+  std::vector<unsigned> uIndex;
+  unsigned iQ = 0;
+  for (double dT : c_uDepositTimes) {
+    uIndex.push_back(uBootstrap.deposit(dT, uQuotes[iQ++]));
+  }
+  uIndex.push_back(uBootstrap.fra(c_dFraStart, c_dFraPeriod, uQuotes[iQ++]));
+  for (unsigned iN : c_uSwapPayments) {
+    uIndex.push_back(uBootstrap.swap(swap(iN, uQuotes[iQ++])));
+  }
+  double dAdd = residual(uBootstrap, uQuotes);
+  cout << "tolerance = " << c_dTolerance << endl;
+  cout << "largest par residual after add = " << dAdd << endl;
+  bool bPassed = (dAdd <= c_dTolerance);
+
+  //the longest swap does not affect other knots
+  uQuotes.back() += 0.001;
+  uBootstrap.update(uIndex.back(), uQuotes.back());
+  double dLast = residual(uBootstrap, uQuotes);
+  unsigned iLast = uBootstrap.numberOfSolved();
+  cout << "largest par residual after update of the longest swap = " << dLast << endl;
+  cout << "number of solved knots = " << iLast << " (expected 1)" << endl;
+  bPassed = bPassed && (dLast <= c_dTolerance) && (iLast == 1);
+
+  //the second deposit moves all the later knots
+  uQuotes[1] += 0.002;
+  uBootstrap.update(uIndex[1], uQuotes[1]);
+  double dShort = residual(uBootstrap, uQuotes);
+  unsigned iShort = uBootstrap.numberOfSolved();
+  cout << "largest par residual after update of the second deposit = " << dShort << endl;
+  cout << "number of solved knots = " << iShort << " (expected "
+       << uQuotes.size() - 1 << ")" << endl;
+  bPassed = bPassed && (dShort <= c_dTolerance) && (iShort == uQuotes.size() - 1);
+
+  //a deposit rate below -1/period cannot be solved; the new quote of
+  //the forward rate agreement must be discarded together with it
+  std::shared_ptr<const Bootstrap::Curve> pBefore = uBootstrap.curve();
+  bool bThrown = false;
+  try {
+    uBootstrap.update({uIndex[2], uIndex[0]}, {uQuotes[2] + 0.01, -10.});
+  }
+  catch (const std::exception & rError) {
+    cout << "failed update: " << rError.what() << endl;
+    bThrown = true;
+  }
+  unsigned iVersion = uBootstrap.curve()->version;
+  cout << "version before and after failed update = " << pBefore->version
+       << ", " << iVersion << endl;
+  bPassed = bPassed && bThrown && (iVersion == pBefore->version);
+
+  //the new knot inside the period of the forward rate agreement
+  //solves it again with the stored quote
+  uBootstrap.deposit(0.75, 0.032);
+  double dAfter = residual(uBootstrap, uQuotes);
+  cout << "largest par residual after the next deposit = " << dAfter << endl << endl;
+  return bPassed && (dAfter <= c_dTolerance);
+}
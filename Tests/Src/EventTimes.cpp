@@ -0,0 +1,116 @@
+/*-------------------------------------------------------------------------------
+  Description	: checks of addEventTimes and eventIndexes for asset and
+  interest rate models
+  --------------------------------------------------------------------------------*/
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "Tests/Tests.hpp"
+#include "cfl/BlackModel.hpp"
+#include "cfl/HullWhiteModel.hpp"
+
+using namespace cfl;
+using namespace std;
+
+namespace testsEventTimes
+{
+  const double c_dSpot = 100.;
+  const double c_dYield = 0.05;
+  const double c_dDividend = 0.02;
+  const double c_dSigma = 0.2;
+  const double c_dLambda = 0.05;
+  const double c_dRateSigma = 0.01;
+  const double c_dInitialTime = 0.;
+  const double c_dQuality = 200;
+  const double c_dInterval = 0.2;
+  const double c_dPeriod = 0.25;
+  const std::vector<double> c_uEventTimes = {0., 0.25, 0.5, 0.75, 1.};
+  const std::vector<double> c_uExisting = {0.25, 1.};
+  const std::vector<double> c_uNew = {0.6};
+
+  //the running sum of the discount factors for one period
+  template <class TModel>
+  class SumOfDiscounts: public IResetValues
+  {
+  public:
+    SumOfDiscounts(const TModel & rModel)
+      :m_rModel(rModel)
+    {}
+
+    Slice resetValues(unsigned iTime, double dBeforeReset) const
+    {
+      return dBeforeReset + 
+	m_rModel.discount(iTime, m_rModel.eventTimes()[iTime] + c_dPeriod);
+    }
+
+  private:
+    const TModel & m_rModel;
+  };
+
+  //the price of the sum of the discount factors at the last event time
+  template <class TModel>
+  double sumPrice(const TModel & rModel, unsigned iState)
+  {
+    Slice uSum = rModel.state(rModel.eventTimes().size() - 1, iState);
+    uSum.rollback(0);
+    return atOrigin(uSum);
+  }
+
+  template <class TModel>
+  bool check(TModel & rModel, const char * sName)
+  {
+    cout << sName << ":" << endl;
+    rModel.assignEventTimes(c_uEventTimes);
+    unsigned iStates = rModel.numberOfStates();
+    std::vector<unsigned> uResets = {1, 2, 3, 4};
+    unsigned iState = rModel.addState(PathDependent(new SumOfDiscounts<TModel>(rModel),
+						    uResets, 0.));
+    double dPrice = sumPrice(rModel, iState);
+
+    //the existing times keep the model and its path dependent state
+    bool bExisting = rModel.addEventTimes(c_uExisting);
+    bool bKept = !bExisting && (rModel.numberOfStates() == iStates + 1)
+      && (rModel.eventTimes() == c_uEventTimes) 
+      && (sumPrice(rModel, iState) == dPrice);
+    cout << "  existing times: changed = " << bExisting 
+	 << ", states = " << rModel.numberOfStates() << endl;
+    std::vector<unsigned> uIndexes = eventIndexes(rModel.eventTimes(), c_uExisting);
+    bKept = bKept && (uIndexes == std::vector<unsigned>({1, 4}));
+
+    bool bThrown = false;
+    try {
+      eventIndexes(rModel.eventTimes(), c_uNew);
+    }
+    catch (const std::exception & rError) {
+      cout << "  missing time: " << rError.what() << endl;
+      bThrown = true;
+    }
+
+    //a new time rebuilds the model without the path dependent state
+    bool bNew = rModel.addEventTimes(c_uNew);
+    bool bRebuilt = bNew && (rModel.eventTimes().size() == c_uEventTimes.size() + 1)
+      && (rModel.numberOfStates() == iStates) 
+      && (eventIndexes(rModel.eventTimes(), c_uNew) == std::vector<unsigned>(1, 3));
+    cout << "  new time: changed = " << bNew 
+	 << ", states = " << rModel.numberOfStates() << endl;
+    return bKept && bThrown && bRebuilt;
+  }
+}
+
+bool tests::eventTimes()
+{
+  using namespace testsEventTimes;
+
+  cout << "ADDITION OF EVENT TIMES" << endl;
+  Function uDiscount = cfl::Data::discount(c_dYield, c_dInitialTime);
+  Function uForward = cfl::Data::forward(c_dSpot, c_dDividend, uDiscount, c_dInitialTime);
+  Black::Data uBlack(uDiscount, uForward, c_dSigma, c_dInitialTime);
+  AssetModel uAsset = Black::model(uBlack, c_dInterval, c_dQuality);
+  bool bAsset = check(uAsset, "Black model");
+
+  HullWhite::Data uHullWhite(uDiscount, c_dRateSigma, c_dLambda, c_dInitialTime);
+  InterestRateModel uRate = HullWhite::model(uHullWhite, c_dInterval, c_dQuality);
+  bool bRate = check(uRate, "Hull and White model");
+  cout << endl;
+  return bAsset && bRate;
+}
@@ -0,0 +1,22 @@
+#include <iostream>
+#include <string>
+#include <map>
+#include "Tests/Tests.hpp"
+
+int main(int argc, char * argv[])
+{
+  const std::map<std::string, bool (*)()> uTests = {
+    {"tabulate", tests::tabulate},
+    {"tangent", tests::tangent},
+    {"bootstrap", tests::bootstrap},
+    {"blackAnalytic", tests::blackAnalytic},
+    {"eventTimes", tests::eventTimes}
+  };
+  if (argc != 2 || uTests.count(argv[1]) == 0) {
+    std::cerr << "usage: Tests <name of the check>" << std::endl;
+    return 2;
+  }
+  bool bPassed = uTests.at(argv[1])();
+  std::cout << (bPassed ? "passed" : "FAILED") << std::endl;
+  return bPassed ? 0 : 1;
+}
@@ -0,0 +1,51 @@
+/*-------------------------------------------------------------------------------
+  Description	: checks of the tolerance of cfl::tabulate
+  --------------------------------------------------------------------------------*/
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include "Tests/Tests.hpp"
+#include "cfl/Interp.hpp"
+
+using namespace cfl;
+using namespace std;
+
+namespace testsTabulate
+{
+  const double c_dLeft = 0.;
+  const double c_dRight = 3.;
+  const double c_dTolerance = 1e-8;
+  const unsigned c_iPoints = 100000;
+}
+
+bool tests::tabulate()
+{
+  using namespace testsTabulate;
+
+  cout << "TABULATE" << endl;
+  Function uSin = toFunction([](double dX) { return std::sin(dX); });
+  Function uTable = cfl::tabulate(uSin, c_dLeft, c_dRight, c_dTolerance);
+  double dErr = 0.;
+  for (unsigned iI=0; iI<=c_iPoints; iI++) {
+    double dX = c_dLeft + iI*(c_dRight - c_dLeft)/c_iPoints;
+    dErr = std::max(dErr, std::abs(uTable(dX) - uSin(dX)));
+  }
+  cout << "tolerance = " << c_dTolerance << endl;
+  cout << "largest error for sin = " << dErr << endl;
+  bool bPassed = (dErr <= c_dTolerance);
+
+  Function uKink = toFunction([](double dX) { return std::abs(dX - 0.3); });
+  bool bThrown = false;
+  try {
+    cfl::tabulate(uKink, c_dLeft, c_dRight, c_dTolerance);
+  }
+  catch (const std::exception & rError) {
+    cout << "kink at 0.3: " << rError.what() << endl;
+    bThrown = true;
+  }
+  if (!bThrown) {
+    cout << "kink at 0.3: no exception" << endl;
+  }
+  cout << endl;
+  return bPassed && bThrown;
+}
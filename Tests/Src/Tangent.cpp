@@ -0,0 +1,75 @@
+/*-------------------------------------------------------------------------------
+  Description	: checks of the forward derivatives of Function::tangent
+  against the differences of rebuilt curves
+  --------------------------------------------------------------------------------*/
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "Tests/Tests.hpp"
+#include "cfl/Interp.hpp"
+#include "cfl/Data.hpp"
+
+using namespace cfl;
+using namespace std;
+
+namespace testsTangent
+{
+  const double c_dInitialTime = 0.;
+  const double c_dBump = 1e-6;
+  const double c_dTolerance = 1e-6;
+  const std::vector<double> c_uTimes = {0.5, 1., 2., 3., 5., 7., 10.};
+  const std::vector<double> c_uYields = {0.03, 0.032, 0.035, 0.037, 0.04, 0.041, 0.042};
+  const std::vector<double> c_uPoints = {0.5, 0.75, 1.5, 2.5, 4., 6., 8.5, 10.};
+
+  //the discount curve built from the seeded spline of yields
+  Function discount(const std::vector<double> & rYields)
+  {
+    Function uYield = seed(NInterp::spline(), c_uTimes, rYields);
+    return cfl::Data::discount(uYield, c_dInitialTime);
+  }
+
+  //the compiled curve which mixes the discount curve with the yield
+  Function curve(const std::vector<double> & rYields)
+  {
+    Function uYield = seed(NInterp::spline(), c_uTimes, rYields);
+    Function uDiscount = cfl::Data::discount(uYield, c_dInitialTime);
+    return compile(uDiscount*exp(-0.5*uYield) + uYield*uYield - 2.);
+  }
+
+  //the largest difference between the tangents of rBuild(c_uYields)
+  //and the central differences of the curves rebuilt with the
+  //bumped yields
+  template <class F>
+  double error(F rBuild)
+  {
+    Function uF = rBuild(c_uYields);
+    unsigned iN = c_uYields.size();
+    std::vector<double> uTangent(iN);
+    double dErr = 0.;
+    for (double dX : c_uPoints) {
+      uF.tangent(dX, uTangent.data(), iN);
+      for (unsigned iI=0; iI<iN; iI++) {
+	std::vector<double> uUp(c_uYields), uDown(c_uYields);
+	uUp[iI] += c_dBump;
+	uDown[iI] -= c_dBump;
+	double dBumped = (rBuild(uUp)(dX) - rBuild(uDown)(dX))/(2.*c_dBump);
+	dErr = std::max(dErr, std::abs(uTangent[iI] - dBumped));
+      }
+    }
+    return dErr;
+  }
+}
+
+bool tests::tangent()
+{
+  using namespace testsTangent;
+
+  cout << "TANGENT" << endl;
+  double dDiscount = error(discount);
+  double dCurve = error(curve);
+  cout << "tolerance = " << c_dTolerance << endl;
+  cout << "largest error for Data::discount of seeded spline = " << dDiscount << endl;
+  cout << "largest error for compiled curve = " << dCurve << endl << endl;
+  return (dDiscount <= c_dTolerance) && (dCurve <= c_dTolerance);
+}
@@ -0,0 +1,52 @@
+#ifndef __Tests_hpp__
+#define __Tests_hpp__
+
+/**
+ * \file   Tests.hpp
+ * 
+ * \brief Checks of the library registered with ctest. 
+ *
+ * Every check prints the quantities it compares and returns \p true
+ * if all of them are within the tolerance.
+ */
+
+namespace tests
+{
+  /** 
+   * Checks cfl::tabulate: the tolerance is met on a smooth function
+   * and NError::range is thrown for a function with a kink.
+   */
+  bool tabulate();
+
+  /** 
+   * Checks the derivatives returned by Function::tangent for a
+   * seeded spline of yields passed through Data::discount and for a
+   * curve built by cfl::compile against the central differences of
+   * the curves rebuilt with bumped yields.
+   */
+  bool tangent();
+
+  /** 
+   * Checks cfl::Bootstrap: the par residuals after the instruments
+   * are added and after the updates, the number of solved knots for
+   * a localised update and that a failed update keeps the curve and
+   * the quotes.
+   */
+  bool bootstrap();
+
+  /** 
+   * Checks Black::price and Black::controlVariate for every type of
+   * European payoff against the numerical prices in Black model.
+   */
+  bool blackAnalytic();
+
+  /** 
+   * Checks AssetModel::addEventTimes and
+   * InterestRateModel::addEventTimes: the existing times keep the
+   * model and its path dependent states, a new time rebuilds the
+   * model, and cfl::eventIndexes throws for a missing time.
+   */
+  bool eventTimes();
+}
+
+#endif // of __Tests_hpp__
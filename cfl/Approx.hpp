@@ -72,6 +72,29 @@ namespace cfl
      * \returns The result of numerical approximation of the function.
      */
     virtual Function approximate(const std::valarray<double>& rValues) const = 0;		
+
+    /**
+     * Recovers several one-dimensional functions from their values
+     * at the nodes of the approximation scheme and evaluates the
+     * results of approximation at given points. The values and the
+     * points are stored row by row in matrices with \a iColumns
+     * columns, one column for every function. The default
+     * implementation calls approximate(const std::valarray<double> &)
+     * for every column.
+     * \param pValues The pointer to the matrix of values at the
+     * nodes. Its row \p j contains the values of the functions at the
+     * node \p arg()[j].
+     * \param iColumns The number of functions.
+     * \param pArg The pointer to the matrix of points. The
+     * approximation of the function from column \p i is evaluated at the
+     * points from the same column.
+     * \param iPoints The number of rows in the matrix of points. 
+     * \param pResult The pointer to the matrix of results. It has the
+     * same size as the matrix of points. 
+     */
+    virtual void approximate(const double * pValues, unsigned iColumns, 
+			     const double * pArg, unsigned iPoints, 
+			     double * pResult) const;
   };
 
 	
@@ -108,6 +131,12 @@ namespace cfl
      */
     Function approximate(const std::valarray<double> & rValues) const;
 
+    /**
+     * \copydoc IApprox::approximate(const double *, unsigned, const double *, unsigned, double *) const
+     */
+    void approximate(const double * pValues, unsigned iColumns, 
+		     const double * pArg, unsigned iPoints, double * pResult) const;
+
   private:
     std::shared_ptr<IApprox> m_uP;
   };
@@ -140,6 +169,22 @@ namespace cfl
      */
     Approx toApprox(const Function & rSize, const Interp & rInterp);
   }
+
+  /**
+   * Returns the approximation of the function with the values \a
+   * rValues at the nodes of \a rApprox, where the values are the
+   * parameters with the indexes \a iFirst, ..., \a iFirst +
+   * rValues.size() - 1. The derivatives with respect to these
+   * parameters are returned by Function::tangent for all functions
+   * built from the result. \see cfl::seed
+   * \param rApprox The approximation scheme after the assignment
+   * of the interval.
+   * \param rValues The values at the nodes of \a rApprox.
+   * \param iFirst The index of the first parameter.
+   * \return The approximating function with the parameters.
+   */
+  Function seed(const Approx & rApprox, const std::valarray<double> & rValues, 
+		unsigned iFirst = 0);
   //@}
 }
 
@@ -93,8 +93,23 @@ namespace cfl
      * AssetModel::addState will be deleted. 
      * \param rEventTimes The new vector of event times for the model. The front element of this 
      * vector should equal the initial time of the model. Otherwise, an error is thrown. 
+     * If \a rEventTimes coincide with the current event times, then the 
+     * implementation of the model and its caches are kept. 
      */
     void assignEventTimes(const std::vector<double> & rEventTimes);
+
+    /** 
+     * Adds the times \a rEventTimes to the event times of the model. 
+     * If all of them are already event times, then the model, its 
+     * caches, and the state processes are kept. Otherwise, the
+     * function is equivalent to 
+     * <code>assignEventTimes(merge(eventTimes(), rEventTimes))</code>. 
+     * The indexes of the times in the new event times are given by 
+     * the function eventIndexes. 
+     * \param rEventTimes The additional event times (in increasing order). 
+     * \return \p true if the event times have changed. 
+     */
+    bool addEventTimes(const std::vector<double> & rEventTimes);
     
     /**
      * \copydoc Extended::addState
@@ -105,6 +120,11 @@ namespace cfl
      * \copydoc IModel::numberOfStates  
      */ 
     unsigned numberOfStates() const;
+
+    /**
+     * \copydoc Extended::numberOfApproxNodes
+     */ 
+    unsigned numberOfApproxNodes(bool bFixedPolicy = false) const;
     
     /**
      * \copydoc IModel::eventTimes
@@ -92,6 +92,26 @@ namespace cfl
      * are related by the linear equation: <code> y = Ax </code>.
      */
     void solve(std::valarray<double> & rX) const;
+
+    /** 
+     * Solves the linear equation <code> y = Ax </code> in place
+     * without temporary arrays. 
+     * \param pX The pointer to the first element of the array. \em
+     * Before the operation the array coincides with \p y and \em
+     * after the operation it coincides with \p x. 
+     */
+    void solve(double * pX) const;
+
+    /** 
+     * Solves the linear equation <code> y = Ax </code> for several
+     * right-hand sides at once. The vectors \p y are stored row by
+     * row as the columns of the matrix \a rX.
+     * \param rX \em Before the operation the columns of \a rX are
+     * the vectors \p y and \em after the operation they are the
+     * solutions \p x.
+     * \param iColumns The number of right-hand sides. 
+     */
+    void solve(std::valarray<double> & rX, unsigned iColumns) const;
 		
     /** 
      * Replaces \p this with tridiagonal matrix which elements 
@@ -108,6 +128,37 @@ namespace cfl
     std::valarray<double> m_uL, m_uD, m_uU;
   };
 
+  //! Scratch array of doubles. 
+  /**
+   * This class provides a temporary array of doubles. If the size
+   * does not exceed \a N then the array is kept on the stack,
+   * otherwise it is allocated on the heap.
+   */
+  template <unsigned N>
+  class Scratch
+  {
+  public:
+    /** 
+     * Constructs the array of the size \a iSize. 
+     * \param iSize The size of the array. 
+     */
+    explicit Scratch(unsigned iSize);
+
+    /** 
+     * Returns the pointer to the first element of the array. 
+     * \return The pointer to the first element of the array. 
+     */
+    double * begin();
+
+  private:
+    Scratch(const Scratch &);
+    Scratch & operator=(const Scratch &);
+
+    double m_uStack[N];
+    std::vector<double> m_uHeap;
+    double * m_pBegin;
+  };
+
   //@}
 }
 
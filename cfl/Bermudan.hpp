@@ -0,0 +1,110 @@
+#ifndef __cflBermudan_hpp__
+#define __cflBermudan_hpp__
+
+#include <vector>
+#include "cfl/InterestRateModel.hpp"
+
+/**
+ * \file   Bermudan.hpp
+ *
+ * \brief Bermudan swaptions and callable bonds in interest rate models.
+ *
+ * Bermudan swaptions and callable bonds are priced as Bermudan
+ * options on coupon bonds. Many trades with a common calendar of
+ * exercise times are priced in one backward induction: the discount
+ * factors for the payment times are computed once for all trades at
+ * every exercise time and the option values are rolled back together.
+ */
+
+namespace cfl
+{
+  /// \addtogroup cflInterestRateModel
+  //@{
+
+  //! Bermudan options in interest rate models.
+  /**
+   * This namespace contains pricers of Bermudan swaptions, callable
+   * bonds and, more generally, Bermudan options on coupon bonds.
+   */
+  namespace Bermudan
+  {
+    /**
+     * Computes the prices of the Bermudan options on the coupon bonds
+     * \a rBonds with the common exercise times \a rExerciseTimes. If
+     * the option is exercised at time \p t, then the holder of a call
+     * receives the payments of the bond after \p t and pays the
+     * strike. For a put it is the other way around.
+     * \param rBonds The payment schedules of the bonds.
+     * \param rStrikes The strikes.
+     * \param rCall The types of the options: \p true for calls and
+     * \p false for puts.
+     * \param rExerciseTimes The exercise times in increasing order.
+     * The first exercise time should be greater than the initial time.
+     * \param rModel The interest rate model.
+     * \return The prices of the options.
+     */
+    std::vector<MultiFunction> option(const std::vector<Data::Schedule> & rBonds,
+				      const std::vector<double> & rStrikes,
+				      const std::vector<bool> & rCall,
+				      const std::vector<double> & rExerciseTimes,
+				      InterestRateModel & rModel);
+
+    /**
+     * Computes the prices of the Bermudan swaptions on the swaps \a
+     * rSwaps. The swaps start at the first exercise time and the
+     * exercise times should be their reset times. If a swaption is
+     * exercised at time \p t, then the holder enters the remaining
+     * part of the swap, that is, the payments after \p t.
+     * \param rSwaps The parameters of the swaps.
+     * \param rExerciseTimes The exercise times in increasing order.
+     * \param rModel The interest rate model.
+     * \return The prices of the swaptions.
+     */
+    std::vector<MultiFunction> swaption(const std::vector<Data::Swap> & rSwaps,
+					const std::vector<double> & rExerciseTimes,
+					InterestRateModel & rModel);
+
+    /**
+     * Computes the price of the Bermudan swaption.
+     * \param rSwap The parameters of the swap.
+     * \param rExerciseTimes The exercise times in increasing order.
+     * \param rModel The interest rate model.
+     * \return The price of the swaption.
+     * \see swaption(const std::vector<Data::Swap> &, const std::vector<double> &, InterestRateModel &)
+     */
+    MultiFunction swaption(const Data::Swap & rSwap,
+			   const std::vector<double> & rExerciseTimes,
+			   InterestRateModel & rModel);
+
+    /**
+     * Computes the prices of the callable bonds \a rBonds. The bonds
+     * are issued at the initial time. At the call times the issuer
+     * can redeem the bonds at the notional amount after the payment
+     * of the coupon. The price equals the price of the bond minus the
+     * price of the Bermudan call on the bond with the strike
+     * equal to the notional.
+     * \param rBonds The parameters of the bonds.
+     * \param rCallTimes The call times in increasing order.
+     * \param rModel The interest rate model.
+     * \return The prices of the callable bonds.
+     */
+    std::vector<MultiFunction> callableBond(const std::vector<Data::CashFlow> & rBonds,
+					    const std::vector<double> & rCallTimes,
+					    InterestRateModel & rModel);
+
+    /**
+     * Computes the price of the callable bond.
+     * \param rBond The parameters of the bond.
+     * \param rCallTimes The call times in increasing order.
+     * \param rModel The interest rate model.
+     * \return The price of the callable bond.
+     * \see callableBond(const std::vector<Data::CashFlow> &, const std::vector<double> &, InterestRateModel &)
+     */
+    MultiFunction callableBond(const Data::CashFlow & rBond,
+			       const std::vector<double> & rCallTimes,
+			       InterestRateModel & rModel);
+  }
+  //@}
+}
+
+#endif // of __cflBermudan_hpp__
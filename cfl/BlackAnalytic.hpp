@@ -0,0 +1,153 @@
+#ifndef __cflBlackAnalytic_hpp__
+#define __cflBlackAnalytic_hpp__
+
+/**
+ * \file   BlackAnalytic.hpp
+ *
+ * \brief Closed-form prices of European options in Black model.
+ *
+ * Contains the batch implementation of the Black formula for
+ * European calls, puts, straddles and digital options. The prices
+ * are computed directly from the parameters of Black model and can
+ * be used as control variates for the numerical pricers. Also
+ * contains the continuity correction for discretely monitored
+ * barriers.
+ */
+
+#include <vector>
+#include "cfl/BlackData.hpp"
+#include "cfl/Slice.hpp"
+
+namespace cfl
+{
+  namespace Black
+  {
+    /// \addtogroup cflBlack
+    //@{
+
+    //! European option on the spot price.
+    /**
+     * This class describes a European option with closed-form price
+     * in Black model.
+     */
+    class European
+    {
+    public:
+      /**
+       * The types of payoffs.
+       */
+      enum Payoff {
+	eCall, ///< max(S - K, 0)
+	ePut, ///< max(K - S, 0)
+	eStraddle, ///< |S - K|
+	eDigitalCall, ///< 1 if S > K and 0 otherwise
+	eDigitalPut ///< 1 if S < K and 0 otherwise
+      };
+
+      /**
+       * The type of the payoff.
+       */
+      Payoff payoff;
+
+      /**
+       * The strike \p K.
+       */
+      double strike;
+
+      /**
+       * The maturity as year fraction.
+       */
+      double maturity;
+    };
+
+    /**
+     * Computes the prices of the options \a rOptions at the initial
+     * time for the relative changes \a pX of the state process. As
+     * for the numerical pricers, the spot price equals \p
+     * rData.forward()(t0)*exp(rData.shape()(t0)*x), where \p t0 is the
+     * initial time. The curves of \a rData are evaluated once for all
+     * maturities; the loops over \a pX do not contain branches and
+     * can be vectorized by the compiler.
+     *
+     * \param rData The parameters of Black model.
+     * \param rOptions The options. Their maturities should not be
+     * less than the initial time.
+     * \param pX The relative changes of the state process.
+     * \param pPrice The prices. The price of the option \p i for \p
+     * pX[j] is stored at \p pPrice[i*iSize + j].
+     * \param iSize The number of elements of \a pX.
+     */
+    void price(const Data & rData, const std::vector<European> & rOptions,
+	       const double * pX, double * pPrice, size_t iSize);
+
+    /**
+     * Computes the price of the option \a rOption at the initial time.
+     *
+     * \param rData The parameters of Black model.
+     * \param rOption The option.
+     *
+     * \return The price of the option as the function of the relative
+     * change of the state process; the interface is the same as for
+     * the numerical pricers.
+     * \see price(const Data &, const std::vector<European> &, const double *, double *, size_t)
+     */
+    MultiFunction price(const Data & rData, const European & rOption);
+
+    /**
+     * Computes the payoff of the option \a rOption.
+     *
+     * \param rOption The option.
+     * \param rSpot The spot price at the maturity of the option.
+     *
+     * \return The payoff of the option.
+     */
+    Slice payoff(const European & rOption, const Slice & rSpot);
+
+    /**
+     * Improves the numerical price \a rOption by the control variate
+     * \a rControl. The same model and event times should be used to
+     * compute \a rOption and \a rNumericControl; the result equals \a
+     * rOption - \a rNumericControl + price(\a rData, \a rControl).
+     *
+     * \param rOption The numerical price of the option.
+     * \param rNumericControl The numerical price of the control
+     * option \a rControl.
+     * \param rData The parameters of Black model.
+     * \param rControl The control option.
+     *
+     * \return The price of the option with the control variate.
+     */
+    MultiFunction controlVariate(const MultiFunction & rOption,
+				 const MultiFunction & rNumericControl,
+				 const Data & rData, const European & rControl);
+
+    /**
+     * Computes the continuity correction of Broadie, Glasserman and
+     * Kou for a barrier on the spot price. The price of the option with
+     * the barrier \a dBarrier monitored with the period \a dPeriod is
+     * approximately equal to the price of the same option with the
+     * returned barrier monitored continuously. Together with the
+     * rollback of knock-out payoffs between event times, it allows us
+     * to price, for example, daily monitored barriers with weekly
+     * event times. The rollback between event times does not monitor
+     * the barrier for payoffs that depend on the path dependent
+     * states of the model; such payoffs need all monitoring times as
+     * event times.
+     *
+     * \param dBarrier The barrier.
+     * \param bLower \p true for a lower and \p false for an upper barrier.
+     * \param dVolatility The volatility of the spot price.
+     * \param dPeriod The period of monitoring as year fraction.
+     *
+     * \return The barrier moved away from the spot price by the
+     * factor \p exp(0.5826*dVolatility*sqrt(dPeriod)).
+     * \see cfl::rollback(const Slice &, unsigned, const Slice &, const Slice &, double, double)
+     */
+    double continuousBarrier(double dBarrier, bool bLower, 
+			     double dVolatility, double dPeriod);
+    //@}
+  }
+}
+
+#include "cfl/Inline/iBlackAnalytic.hpp"
+#endif // of __cflBlackAnalytic_hpp__
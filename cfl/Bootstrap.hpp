@@ -0,0 +1,200 @@
+#ifndef __cflBootstrap_hpp__
+#define __cflBootstrap_hpp__
+
+#include <memory>
+#include <vector>
+#include "cfl/Data.hpp"
+
+/**
+ * \file   Bootstrap.hpp
+ *
+ * \brief Incremental bootstrapping of discount curves.
+ *
+ * This file contains the class that bootstraps a discount curve from
+ * the quotes of deposits, forward rate agreements, futures and swaps
+ * and updates it when some of the quotes change.
+ */
+
+namespace cfl
+{
+  /**
+   * \ingroup cflCommonElements
+   * \defgroup cflBootstrap Bootstrapping of discount curves.
+   * This module contains the class that bootstraps a discount curve
+   * from market quotes.
+   */
+  //@{
+
+  //! Incremental bootstrapping of a discount curve.
+  /**
+   * Every instrument adds a knot to the discount curve at its
+   * maturity. The logarithm of the discount factor is linear between
+   * the knots and the knots are solved one by one in the increasing
+   * order of maturities. When quotes change, only the knots that
+   * depend on them are solved again.
+   *
+   * The results are published as immutable snapshots of the curve.
+   * The function curve() can be called by pricers in other threads
+   * while the quotes are updated; a snapshot does not change after
+   * its publication.
+   *
+   * If the knots cannot be solved, then the functions that add
+   * instruments or update quotes throw an exception and leave the
+   * instruments, the quotes and the curve unchanged.
+   *
+   * All rates are simple rates; the accrual periods are given as year
+   * fractions.
+   */
+  class Bootstrap
+  {
+  public:
+    //! Immutable snapshot of the discount curve.
+    class Curve
+    {
+    public:
+      /**
+       * The version of the curve. It is increased by every update.
+       */
+      unsigned version;
+
+      /**
+       * The maturities of the instruments in increasing order.
+       */
+      std::vector<double> times;
+
+      /**
+       * The discount factors for the maturities \p times.
+       */
+      std::vector<double> discountFactors;
+
+      /**
+       * The log-linear discount curve with the knots \p times.
+       * \see Data::discount
+       */
+      Function discount;
+    };
+
+    /**
+     * Constructs the bootstrapping engine without instruments.
+     * \param dInitialTime The initial time as year fraction.
+     */
+    explicit Bootstrap(double dInitialTime);
+
+    /**
+     * Adds the deposit with the simple rate \a dRate from the initial
+     * time to \a dMaturity.
+     * \param dMaturity The maturity of the deposit.
+     * \param dRate The deposit rate.
+     * \return The index of the quote.
+     */
+    unsigned deposit(double dMaturity, double dRate);
+
+    /**
+     * Adds the forward rate agreement with the simple rate \a dRate
+     * for the period [\a dStart, \a dStart + \a dPeriod].
+     * \param dStart The start of the accrual period.
+     * \param dPeriod The length of the accrual period.
+     * \param dRate The forward rate.
+     * \return The index of the quote.
+     */
+    unsigned fra(double dStart, double dPeriod, double dRate);
+
+    /**
+     * Adds the future on LIBOR for the period [\a dStart, \a dStart +
+     * \a dPeriod]. The future price is quoted as 1 - LIBOR. The
+     * forward rate equals the future rate minus the convexity
+     * adjustment \a dConvexity.
+     * \param dStart The start of the LIBOR period.
+     * \param dPeriod The length of the LIBOR period.
+     * \param dPrice The future price.
+     * \param dConvexity The convexity adjustment.
+     * \return The index of the quote.
+     * \see prb::futureOnLibor
+     */
+    unsigned future(double dStart, double dPeriod, double dPrice,
+		    double dConvexity = 0.);
+
+    /**
+     * Adds the swap which starts at the initial time and has the
+     * par rate \a rSwap.rate. The notional and the side of the
+     * contract are not used.
+     * \param rSwap The parameters of the swap.
+     * \return The index of the quote.
+     */
+    unsigned swap(const Data::Swap & rSwap);
+
+    /**
+     * Replaces the quote with the index \a iQuote by \a dQuote (the
+     * rate or the future price) and publishes the new curve.
+     * \param iQuote The index of the quote.
+     * \param dQuote The new value of the quote.
+     */
+    void update(unsigned iQuote, double dQuote);
+
+    /**
+     * Replaces several quotes and publishes the new curve once.
+     * \param rQuotes The indexes of the quotes.
+     * \param rValues The new values of the quotes.
+     */
+    void update(const std::vector<unsigned> & rQuotes,
+		const std::vector<double> & rValues);
+
+    /**
+     * Returns the last published snapshot of the curve. The snapshot
+     * is empty before the first instrument is added. This function
+     * can be called concurrently with the updates.
+     * \return The current snapshot of the discount curve.
+     */
+    std::shared_ptr<const Curve> curve() const;
+
+    /**
+     * Returns the number of knots solved during the last update.
+     * \return The number of knots solved during the last update.
+     */
+    unsigned numberOfSolved() const;
+
+  private:
+    enum Type { eDeposit, eFra, eFuture, eSwap };
+
+    struct Instrument
+    {
+      Type eType;
+      //the first date of the instrument that depends on other knots
+      double dStart;
+      double dMaturity, dPeriod, dQuote, dConvexity;
+      unsigned iPayments;
+    };
+
+    //the instruments and the knots of the curve
+    struct Knots
+    {
+      std::vector<Instrument> instruments;
+      //the indexes of the instruments in the order of maturities
+      std::vector<unsigned> order;
+      //the knots of the curve; the first knot is the initial time
+      std::vector<double> time, logDiscount;
+    };
+
+    unsigned add(const Instrument & rInstrument);
+    //solves in rKnots the knots rForced and the knots which depend on
+    //them and returns the number of solved knots; bNewKnot is true if
+    //a knot has been inserted
+    unsigned rebuild(Knots & rKnots, const std::vector<unsigned> & rForced,
+		     bool bNewKnot = false) const;
+    double residual(const Knots & rKnots, const Instrument & rI) const;
+    double logDiscount(const Knots & rKnots, double dT) const;
+    //replaces the knots by rKnots and publishes the new curve
+    void publish(Knots & rKnots, unsigned iSolved);
+
+    double m_dInitialTime;
+    //the knots are replaced only after all of them are solved, so a
+    //failed update leaves the engine unchanged
+    Knots m_uKnots;
+    unsigned m_iSolved, m_iVersion;
+    std::shared_ptr<const Curve> m_pCurve;
+  };
+  //@}
+}
+
+#include "cfl/Inline/iBootstrap.hpp"
+#endif // of __cflBootstrap_hpp__
@@ -136,11 +136,29 @@ namespace cfl
      */
     void rollback(Slice & rSlice, unsigned iEventTime) const;
 
+    /**
+     * \copydoc IModel::rollback(std::vector<Slice> &, unsigned) const
+     */
+    void rollback(std::vector<Slice> & rSlices, unsigned iEventTime) const;
+
+    /**
+     * \copydoc IModel::rollback(Slice &, unsigned, const Slice &, const Slice &, double, double) const
+     */
+    void rollback(Slice & rSlice, unsigned iEventTime, 
+		  const Slice & rStart, const Slice & rEnd, 
+		  double dLowerBarrier, double dUpperBarrier) const;
+
     /**
      * \copydoc IModel::indicator
      */  
     void indicator(Slice & rSlice, double dBarrier) const;
 
+    /**
+     * \copydoc IModel::indicator(const Slice &, const std::vector<double> &) const
+     */  
+    std::vector<Slice> indicator(const Slice & rSlice, 
+				 const std::vector<double> & rBarriers) const;
+
     /**
      * \copydoc IModel::interpolate
      */	
@@ -171,7 +189,7 @@ namespace cfl
     Brownian model(double dQuality, 
 		   const GaussRollback & rRollback = NGaussRollback::improved(), 
 		   const Ind & rInd = NInd::smart(), 
-		   const Interp & rInterp = NInterp::spline()
+		   const Interp & rInterp = NInterp::fastSpline()
 		   );	
   }
   //@}
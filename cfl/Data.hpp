@@ -72,6 +72,43 @@ namespace cfl
      */
     Function discount(const Function & rYield, double dInitialTime);
 
+    /** 
+     * Constructs discount curve from the discount factors \a
+     * rDiscount for the maturities \a rTimes. The logarithm of the
+     * discount factor is interpolated linearly between the
+     * maturities; the discount factor at \a dInitialTime equals 1.
+     * The logarithms of the discount factors and the slopes are
+     * computed once; the batch evaluation does not call other
+     * function objects.
+     * 
+     * \param rTimes The maturities (in increasing order) as year
+     * fractions. They should not be less than \a dInitialTime. 
+     * \param rDiscount The discount factors for \a rTimes.
+     * \param dInitialTime The initial time as year fraction. 
+     * 
+     * \return The discount curve on the interval [\a dInitialTime,
+     * \a rTimes.back()].
+     */
+    Function discount(const std::vector<double> & rTimes, 
+		      const std::vector<double> & rDiscount, double dInitialTime);
+
+    /** 
+     * Tabulates the discount curve \a rDiscount at the maturities \a
+     * rTimes. The result is the log-linear discount curve with the
+     * knots \a rTimes; it coincides with \a rDiscount at the knots
+     * up to the round-off errors.
+     * 
+     * \param rDiscount The discount curve. 
+     * \param rTimes The maturities (in increasing order) as year
+     * fractions.
+     * \param dInitialTime The initial time as year fraction. 
+     * 
+     * \return The log-linear discount curve on the interval [\a
+     * dInitialTime, \a rTimes.back()].
+     */
+    Function tabulateDiscount(const Function & rDiscount, 
+			      const std::vector<double> & rTimes, double dInitialTime);
+
     /** 
      * Constructs stationary volatility curve. The value of volatility
      * for time \p dT, given as year fraction, equals 
@@ -156,6 +193,52 @@ namespace cfl
      */
     Function bondShape(double dLambda, double dInitialTime);
 
+    /** 
+     * Fits the stationary form of discount curve in Hull and White
+     * model to the discount factors \a rDiscount. The discount factor
+     * for maturity \p dT equals
+     * 
+     * \code exp(-A*(1-exp(-dLambda*(dT-dInitialTime)))/dLambda) \endcode
+     * 
+     * where the constant \p A is the least square fit of the yields
+     * of \a rDiscount. The fit is performed once; the result is
+     * given in closed form.
+     * 
+     * \param rTimes The maturities (strictly greater than \a
+     * dInitialTime) of the discount factors.
+     * \param rDiscount The discount factors. 
+     * \param dLambda The mean-reversion rate. 
+     * \param dInitialTime The initial time as year fraction. 
+     * 
+     * \return The fitted discount curve.
+     * \see bondShape
+     */
+    Function discountFit(const std::vector<double> & rTimes, 
+			 const std::vector<double> & rDiscount, 
+			 double dLambda, double dInitialTime);
+
+    /** 
+     * Fits the stationary volatility curve to the volatilities \a
+     * rVolatility. The volatility for maturity \p dT equals
+     * 
+     * \code A*sqrt((1-exp(-2*dLambda*(dT-dInitialTime)))/(2*dLambda*(dT-dInitialTime))) \endcode
+     * 
+     * where the constant \p A is the least square fit of \a
+     * rVolatility. The fit is performed once; the result is given
+     * in closed form.
+     * 
+     * \param rTimes The maturities of the volatilities. 
+     * \param rVolatility The volatilities. 
+     * \param dLambda The mean-reversion rate. 
+     * \param dInitialTime The initial time as year fraction. 
+     * 
+     * \return The fitted volatility curve.
+     * \see volatility
+     */
+    Function volatilityFit(const std::vector<double> & rTimes, 
+			   const std::vector<double> & rVolatility, 
+			   double dLambda, double dInitialTime);
+
     //! Cash flow at fixed rate over regular time intervals. 
     /**
      * This class describes the cash flow which takes place 
@@ -221,6 +304,109 @@ namespace cfl
        */ 
       bool payFloat;
     };
+
+    //! Payment schedule of a coupon bond.
+    /**
+     * This class contains the payment times, the accrual periods and
+     * the payments of a coupon bond. The schedule is built once from
+     * CashFlow and then used for many valuation times. The last
+     * payment includes the notional amount.
+     * \see CashFlow
+     */
+    class Schedule
+    {
+    public:
+      /**
+       * Default constructor.
+       */
+      Schedule(){};
+
+      /**
+       * Constructs the schedule of the coupon bond with the
+       * parameters \a rCashFlow issued at \a dIssueTime. The coupons
+       * are paid at the times \p dIssueTime + i * \p rCashFlow.period,
+       * \p i = 1, ..., \p rCashFlow.numberOfPayments.
+       * \param rCashFlow The parameters of the coupon bond.
+       * \param dIssueTime The issue time as year fraction.
+       */
+      Schedule(const CashFlow & rCashFlow, double dIssueTime);
+
+      /**
+       * Accessor function to the issue time.
+       * \return The issue time as year fraction.
+       */
+      double issueTime() const;
+
+      /**
+       * Accessor function to the payment times.
+       * \return The payment times in increasing order.
+       */
+      const std::vector<double> & paymentTimes() const;
+
+      /**
+       * Accessor function to the accrual periods.
+       * \return The lengths of the accrual periods which end at the
+       * payment times.
+       */
+      const std::vector<double> & accrualPeriods() const;
+
+      /**
+       * Accessor function to the payments.
+       * \return The payments at the payment times.
+       */
+      const std::vector<double> & payments() const;
+
+      /**
+       * Returns the index of the first payment after \a dTime.
+       * \param dTime The time as year fraction.
+       * \return The index of the first payment time which is greater
+       * than \a dTime or the number of payments if there is no such
+       * time.
+       */
+      unsigned next(double dTime) const;
+
+      /**
+       * Computes the interest accrued from the last payment (or
+       * issue) time up to \a dTime.
+       * \param dTime The time as year fraction.
+       * \return The accrued interest at \a dTime.
+       */
+      double accruedInterest(double dTime) const;
+
+      /**
+       * Computes the forward prices of the bond for the valuation
+       * times \a pTime. The discount curve is evaluated once at the
+       * payment times and once at the valuation times.
+       * \param rDiscount The discount curve.
+       * \param pTime The valuation times (in any order).
+       * \param pPrice The forward prices for \a pTime.
+       * \param iSize The number of valuation times.
+       * \param bClean If \p true, then the accrued interest is
+       * subtracted from the prices.
+       */
+      void forwardPrice(const Function & rDiscount, const double * pTime,
+			double * pPrice, size_t iSize, bool bClean) const;
+
+    private:
+      double m_dIssueTime, m_dNotional, m_dRate;
+      std::vector<double> m_uTime, m_uPeriod, m_uPayment;
+    };
+
+    /**
+     * Constructs the forward price curve for the coupon bond with the
+     * schedule \a rSchedule. The batch evaluation of the curve
+     * evaluates \a rDiscount only once at every payment time.
+     * \param rSchedule The payment schedule of the bond.
+     * \param rDiscount The discount curve.
+     * \param bClean If \p true, then we compute "clean" prices.
+     * Otherwise, we compute "dirty" prices that include the accrued
+     * interest.
+     * \return The forward price curve on the interval [\a
+     * rSchedule.issueTime(), \a rSchedule.paymentTimes().back()].
+     * \see Schedule::forwardPrice
+     */
+    Function forwardPrice(const Schedule & rSchedule,
+			  const Function & rDiscount, bool bClean);
     //@}
   }
   //@}
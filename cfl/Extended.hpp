@@ -131,11 +131,29 @@
        */
       void rollback(Slice & rSlice, unsigned iEventTime) const;
 
+      /**
+       * \copydoc IModel::rollback(std::vector<Slice> &, unsigned) const
+       */
+      void rollback(std::vector<Slice> & rSlices, unsigned iEventTime) const;
+
+      /**
+       * \copydoc IModel::rollback(Slice &, unsigned, const Slice &, const Slice &, double, double) const
+       */
+      void rollback(Slice & rSlice, unsigned iEventTime, 
+		    const Slice & rStart, const Slice & rEnd, 
+		    double dLowerBarrier, double dUpperBarrier) const;
+
       /**
        * \copydoc IModel::indicator
        */
       void indicator(Slice & rSlice, double dBarrier) const;
 
+      /**
+       * \copydoc IModel::indicator(const Slice &, const std::vector<double> &) const
+       */
+      std::vector<Slice> indicator(const Slice & rSlice, 
+				   const std::vector<double> & rBarriers) const;
+
       /**
        * \copydoc IModel::interpolate
        */
@@ -147,6 +165,22 @@
        */
       const IModel * ptrToModel() const;
 
+      /**
+       * Returns the total number of nodes used for the numerical
+       * approximation of the additional state processes: the sum over
+       * all these processes and over all intervals between their
+       * reset times.
+       * \param bFixedPolicy If \p true, then the function returns the
+       * number of nodes that the fixed policy (where the number of
+       * nodes depends only on the width of the interval) would
+       * use. It differs from the actual number only for the models
+       * created by NExtended::adaptive(). The states added by other
+       * implementations of IExtend than those of NExtended are not
+       * counted.
+       * \return The total number of nodes for additional state processes. 
+       */
+      unsigned numberOfApproxNodes(bool bFixedPolicy = false) const;
+
     private:
       std::vector<std::shared_ptr<IExtend> >  m_uExtend;
       std::vector<std::shared_ptr<IModel> > m_uModels;
@@ -189,6 +223,78 @@
        * \return Implementation of class Extended.  
        */
       Extended model(const std::vector<double> & rQuality);
+
+      /** 
+       * Implements the extended model where all path dependent
+       * state processes are kept in one model. The values of a slice
+       * form one contiguous tensor whose axes are the states of the
+       * original model and the path dependent states. Rollbacks in
+       * the original model and the interpolations at reset times are
+       * performed directly on this tensor; the model avoids the
+       * recursion through the chain of extended models created by
+       * model(const std::vector<Approx> &). It is designed for the
+       * case of two or three path dependent states.
+       * \param rApprox The vector of implementations for numerical
+       * approximation. The \p i-th element is used for the \p i-th
+       * additional state; the last element is used for all remaining
+       * states.
+       * 
+       * \return Implementation of class Extended.  
+       */
+      Extended flat(const std::vector<Approx> & rApprox);
+
+      /** 
+       * Implements the "flat" extended model by using the supplied
+       * method of numerical approximation. 
+       * \param rApprox A method of numerical approximation.  
+       * 
+       * \return Implementation of class Extended.
+       * \see flat(const std::vector<Approx> &)
+       */
+      Extended flat(const Approx & rApprox);
+
+      /** 
+       * Implements the "flat" extended model by using the default
+       * method of numerical approximation.
+       * \param dQuality The quality of the  default method of numerical approximation.
+       * 
+       * \return Implementation of class Extended.  
+       * \see flat(const std::vector<Approx> &)
+       */
+      Extended flat(double dQuality);
+
+      /** 
+       * Implements the "flat" extended model by using the default
+       * methods of numerical approximation.
+       * \param rQuality The qualities of the default methods for numerical approximation.  
+       * 
+       * \return Implementation of class Extended.  
+       * \see flat(const std::vector<Approx> &)
+       */
+      Extended flat(const std::vector<double> & rQuality);
+
+      /** 
+       * Implements the "flat" extended model where the number of
+       * nodes for additional state processes is chosen separately
+       * for every interval between reset times. The number of nodes
+       * given by the default method with quality \a dQuality is an
+       * upper bound. The number of nodes is chosen when the model
+       * is built, before any value is known. The estimate measures
+       * how well the grid reproduces linear and quadratic functions
+       * of the reset values; the number of nodes is the first one in
+       * a sequence with the step of about a quarter for which this
+       * error does not exceed \a dTolerance. Thus few nodes are used when the reset values
+       * are nearly linear and their range is small. The estimate
+       * does not depend on the payoff: the kinks of the value (at a
+       * strike or a barrier) do not add nodes.
+       * \param dQuality The quality of the default method of
+       * numerical approximation.
+       * \param dTolerance The relative tolerance for the error of
+       * approximation.
+       * \return Implementation of class Extended.  
+       * \see flat(const std::vector<Approx> &), Extended::numberOfApproxNodes()
+       */
+      Extended adaptive(double dQuality, double dTolerance);
     }
     //@} 
   }
@@ -3,10 +3,12 @@
 #ifndef __cflFunction_hpp__
 #define __cflFunction_hpp__
 
+#include <cstddef>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <valarray>
+#include <vector>
 #include "cfl/Macros.hpp"
 
 
@@ -21,6 +23,11 @@
  * one-dimensional function object.  
  */
 
+namespace cflFunction
+{
+  class Program;
+}
+
 namespace cfl
 {
   /**
@@ -66,6 +73,31 @@ namespace cfl
      * of the function. Returns \p false otherwise.  
      */
     virtual bool belongs(double dX) const = 0;
+    /**
+     * Evaluates the function at several points. The default
+     * implementation calls operator() for every point. 
+     * \param pX The pointer to the array of arguments.
+     * \param pY The pointer to the array of values. It should not
+     * overlap with the array of arguments.
+     * \param iSize The number of points.
+     */
+    virtual void evaluate(const double * pX, double * pY, size_t iSize) const;
+
+    /**
+     * Evaluates the function together with its derivatives with
+     * respect to \a iTangents parameters (forward mode of automatic
+     * differentiation). The parameters are introduced by cfl::seed
+     * and the derivatives propagate through the operations of the
+     * library. The default implementation treats the function as
+     * independent of the parameters.
+     * \param dX The argument.
+     * \param pTangent The pointer to the array of the size \a
+     * iTangents. On return it holds the derivatives of the value at
+     * \a dX with respect to the parameters.
+     * \param iTangents The number of parameters. 
+     * \return The value of the function at \a dX. 
+     */
+    virtual double tangent(double dX, double * pTangent, unsigned iTangents) const;
   };
 	
   //! Concrete class for a one-dimensional function. 
@@ -120,6 +152,15 @@ namespace cfl
      * \copydoc IFunction::belongs
      */
     bool belongs(double dX) const;
+    /**
+     * \copydoc IFunction::evaluate
+     */
+    void evaluate(const double * pX, double * pY, size_t iSize) const;
+
+    /**
+     * \copydoc IFunction::tangent
+     */
+    double tangent(double dX, double * pTangent, unsigned iTangents) const;
 
     /** 
      * Replaces \p *this with the sum of \p *this and \a rF.  The new
@@ -204,6 +245,7 @@ namespace cfl
     Function & operator/=(double dV);
 		
   private:
+    friend class cflFunction::Program;
     /**
      * The \p shared_ptr to an implementation of IFunction
      */ 
@@ -540,6 +582,39 @@ namespace cfl
 		      unsigned iArg=0, 
 		      const std::valarray<double> & rOtherArg = std::valarray<double>());
 
+  /**
+   * Returns the "compiled" version of \a rF. The tree of arithmetic
+   * operations and standard functions behind \a rF is flattened
+   * into a linear program whose leaves are the remaining function
+   * objects; the operations with constant functions are performed
+   * once. The values and the domain of the result coincide with
+   * those of \a rF.
+   * 
+   * \param rF A function built with the operators of the library.
+   *
+   * \return The function \a rF evaluated without the chain of
+   * nested function objects.
+   */
+  Function compile(const Function & rF);
+
+  /**
+   * Declares the function \a rF as a linear function of the
+   * parameters with the indexes \a iFirst, \a iFirst+1, ...: the
+   * derivative of \a rF with respect to the parameter \a iFirst+j
+   * equals \a rBasis[j]. The values and the domain of the result
+   * coincide with those of \a rF. The derivatives are returned by
+   * Function::tangent for all functions built from the result.
+   * 
+   * \param rF A function which depends linearly on the parameters.
+   * \param rBasis The derivatives of \a rF with respect to the
+   * parameters.
+   * \param iFirst The index of the first parameter.
+   *
+   * \return The function \a rF with the parameters.
+   */
+  Function seed(const Function & rF, const std::vector<Function> & rBasis, 
+		unsigned iFirst = 0);
+
   //@}
 }
 
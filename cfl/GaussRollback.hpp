@@ -65,6 +65,20 @@ namespace cfl
      * respect to the gaussian distribution.
      */
     virtual void rollback(std::valarray<double> & rValues) const = 0;
+
+    /** 
+     * Replaces the values of several functions on the grid with the
+     * values of their conditional expectations with respect to the
+     * gaussian distribution. The values are stored row by row in
+     * the matrix \a rValues with \a iColumns columns, one column for
+     * every function. The default implementation rolls back the
+     * columns one by one.
+     * \param rValues \em Before \p rollback the columns of this
+     * matrix are the original values of the functions. \em After \p
+     * rollback they are replaced with their conditional expectations.
+     * \param iColumns The number of functions. 
+     */
+    virtual void rollback(std::valarray<double> & rValues, unsigned iColumns) const;
   };
 
   //! Concrete class for the operator of conditional expectation with respect to gaussian distribution.
@@ -99,6 +113,11 @@ namespace cfl
      * \copydoc IGaussRollback::rollback()
      */
     void rollback(std::valarray<double> & rValues) const;		
+
+    /**
+     * \copydoc IGaussRollback::rollback(std::valarray<double> &, unsigned) const
+     */
+    void rollback(std::valarray<double> & rValues, unsigned iColumns) const;
   private:
     std::shared_ptr<IGaussRollback> m_uP;
   };
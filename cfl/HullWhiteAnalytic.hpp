@@ -0,0 +1,109 @@
+#ifndef __cflHullWhiteAnalytic_hpp__
+#define __cflHullWhiteAnalytic_hpp__
+
+/**
+ * \file   HullWhiteAnalytic.hpp
+ *
+ * \brief Closed-form prices of caps, floors and swaptions in
+ * Hull and White model.
+ *
+ * Caplets and floorlets are options on zero-coupon bonds. European
+ * swaptions are options on coupon bonds; they are decomposed into
+ * options on zero-coupon bonds by the method of Jamshidian.
+ */
+
+#include <vector>
+#include "cfl/HullWhiteData.hpp"
+#include "cfl/MultiFunction.hpp"
+
+namespace cfl
+{
+  namespace HullWhite
+  {
+    /// \addtogroup cflHullWhite
+    //@{
+
+    /**
+     * Computes the prices of the caps (or floors) \a rCaps at the
+     * initial time for the relative changes \a pX of the state
+     * process. The conventions are the same as for the numerical
+     * pricer \p prb::cap: the first period starts at the initial
+     * time and the rate for a period is set at its beginning. The
+     * curves of \a rData are evaluated once for all trades.
+     *
+     * \param rData The parameters of Hull and White model.
+     * \param rCaps The parameters of the caps.
+     * \param bFloor If \p true, then we compute the prices of floors.
+     * \param pX The relative changes of the state process.
+     * \param pPrice The prices. The price of the trade \p i for \p
+     * pX[j] is stored at \p pPrice[i*iSize + j].
+     * \param iSize The number of elements of \a pX.
+     */
+    void cap(const Data & rData, const std::vector<cfl::Data::CashFlow> & rCaps,
+	     bool bFloor, const double * pX, double * pPrice, size_t iSize);
+
+    /**
+     * Computes the price of the cap \a rCap at the initial time.
+     * \param rData The parameters of Hull and White model.
+     * \param rCap The parameters of the cap.
+     * \return The price of the cap as the function of the relative
+     * change of the state process.
+     */
+    MultiFunction cap(const Data & rData, const cfl::Data::CashFlow & rCap);
+
+    /**
+     * Computes the price of the floor \a rFloor at the initial time.
+     * \param rData The parameters of Hull and White model.
+     * \param rFloor The parameters of the floor.
+     * \return The price of the floor as the function of the relative
+     * change of the state process.
+     */
+    MultiFunction floor(const Data & rData, const cfl::Data::CashFlow & rFloor);
+
+    /**
+     * Computes the prices of the European swaptions on the swaps \a
+     * rSwaps with the maturities \a rMaturities at the initial time
+     * for the relative changes \a pX of the state process. The swaps
+     * start at the maturities of the options. The curves of \a rData
+     * are evaluated once for all trades.
+     *
+     * \param rData The parameters of Hull and White model.
+     * \param rSwaps The parameters of the underlying swaps.
+     * \param rMaturities The maturities of the options.
+     * \param pX The relative changes of the state process.
+     * \param pPrice The prices. The price of the trade \p i for \p
+     * pX[j] is stored at \p pPrice[i*iSize + j].
+     * \param iSize The number of elements of \a pX.
+     */
+    void swaption(const Data & rData, const std::vector<cfl::Data::Swap> & rSwaps,
+		  const std::vector<double> & rMaturities,
+		  const double * pX, double * pPrice, size_t iSize);
+
+    /**
+     * Computes the price of the European swaption at the initial time.
+     * \param rData The parameters of Hull and White model.
+     * \param rSwap The parameters of the underlying swap.
+     * \param dMaturity The maturity of the option.
+     * \return The price of the swaption as the function of the
+     * relative change of the state process.
+     */
+    MultiFunction swaption(const Data & rData, const cfl::Data::Swap & rSwap,
+			   double dMaturity);
+
+    /**
+     * Compares the closed-form price \a rExact with the numerical
+     * price \a rNumeric on the states from the interval [-\a
+     * dInterval/2, \a dInterval/2].
+     * \param rExact The closed-form price.
+     * \param rNumeric The numerical price.
+     * \param dInterval The length of the interval of states.
+     * \param iPoints The number of points in the interval.
+     * \return The maximal absolute difference between the prices.
+     */
+    double validate(const MultiFunction & rExact, const MultiFunction & rNumeric,
+		    double dInterval, unsigned iPoints = 11);
+    //@}
+  }
+}
+
+#endif // of __cflHullWhiteAnalytic_hpp__
@@ -6,6 +6,7 @@
 #include "cfl/Macros.hpp"
 #include <memory>
 #include <valarray>
+#include <vector>
 
 /**
  * \file   Ind.hpp
@@ -54,6 +55,22 @@ namespace cfl
      * \param dBarrier The level of the barrier. 
      */
     virtual void indicator(std::valarray<double> & rValues, double dBarrier) const = 0; 
+
+    /**
+     * Constructs the indicator functions of the events: "the function
+     * is greater than the barrier" for several barriers at once. The
+     * default implementation calls the version with one barrier for
+     * every element of \a rBarriers.
+     * \param rValues The values of the function on a grid. 
+     * \param rBarriers The levels of the barriers. 
+     * \param rInd After the operation this array contains the
+     * indicators for the barriers one after another: the indicator
+     * for the barrier \p rBarriers[k] occupies the positions from \p
+     * k*rValues.size() to \p (k+1)*rValues.size() - 1.
+     */
+    virtual void indicator(const std::valarray<double> & rValues, 
+			   const std::vector<double> & rBarriers, 
+			   std::valarray<double> & rInd) const; 
   };
 	
   //! Standard concrete class for indicator functions. 
@@ -79,6 +96,13 @@ namespace cfl
      */
     void indicator(std::valarray<double> & rValues, 
 		   double dBarrier) const;		
+
+    /**
+     * \copydoc IInd::indicator(const std::valarray<double> &, const std::vector<double> &, std::valarray<double> &) const
+     */
+    void indicator(const std::valarray<double> & rValues, 
+		   const std::vector<double> & rBarriers, 
+		   std::valarray<double> & rInd) const;		
   private:
     std::shared_ptr<IInd> m_pInd;
   };
@@ -18,3 +18,10 @@ cfl::Approx::approximate(const std::valarray<double> & rValues) const
   PRECONDITION(rValues.size() == arg().size());
   return m_uP->approximate(rValues);
 }
+
+inline void 
+cfl::Approx::approximate(const double * pValues, unsigned iColumns, 
+			 const double * pArg, unsigned iPoints, double * pResult) const
+{
+  m_uP->approximate(pValues, iColumns, pArg, iPoints, pResult);
+}
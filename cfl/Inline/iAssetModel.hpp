@@ -6,10 +6,23 @@ cfl::AssetModel::assignEventTimes(const std::vector<double> & rEventTimes)
 {
   //initial time should be the same 
   PRECONDITION(rEventTimes.front() == eventTimes().front());
-  m_pModel.reset(m_pModel->newModel(rEventTimes));
+  if (rEventTimes != eventTimes()) {
+    m_pModel.reset(m_pModel->newModel(rEventTimes));
+  }
   m_uExtended.assign(*m_pModel);
 }
 
+inline bool 
+cfl::AssetModel::addEventTimes(const std::vector<double> & rEventTimes) 
+{
+  std::vector<double> uEventTimes = merge(eventTimes(), rEventTimes);
+  if (uEventTimes.size() == eventTimes().size()) {
+    return false;
+  }
+  assignEventTimes(uEventTimes);
+  return true;
+}
+
 inline unsigned 
 cfl::AssetModel::addState(const PathDependent & rState)
 {
@@ -22,6 +35,12 @@ cfl::AssetModel::numberOfStates() const
   return m_uExtended.numberOfStates();
 }
 
+inline unsigned 
+cfl::AssetModel::numberOfApproxNodes(bool bFixedPolicy) const
+{
+  return m_uExtended.numberOfApproxNodes(bFixedPolicy);
+}
+
 inline const std::vector<double> & 
 cfl::AssetModel::eventTimes() const 
 { 
@@ -23,3 +23,19 @@ inline bool cfl::equal(const std::valarray<T> & rIn1, const std::valarray<T> & r
   return false;
 }
 
+
+template <unsigned N>
+inline cfl::Scratch<N>::Scratch(unsigned iSize)
+  :m_pBegin(m_uStack)
+{
+  if (iSize > N) {
+    m_uHeap.resize(iSize);
+    m_pBegin = m_uHeap.data();
+  }
+}
+
+template <unsigned N>
+inline double * cfl::Scratch<N>::begin()
+{
+  return m_pBegin;
+}
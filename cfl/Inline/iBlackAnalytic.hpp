@@ -0,0 +1,9 @@
+//do not include this file
+
+inline cfl::MultiFunction
+cfl::Black::controlVariate(const MultiFunction & rOption,
+			   const MultiFunction & rNumericControl,
+			   const Data & rData, const European & rControl)
+{
+  return rOption - rNumericControl + price(rData, rControl);
+}
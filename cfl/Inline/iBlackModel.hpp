@@ -5,7 +5,7 @@ inline cfl::AssetModel
 cfl::Black::model(const Data & rData, double dInterval, double dQuality)
 {
   return Black::model(rData, dInterval, NBrownian::model(dQuality), 
-		      NExtended::model(dQuality)); 
+		      NExtended::flat(dQuality)); 
 }
 
 inline cfl::AssetModel 
@@ -13,7 +13,7 @@ cfl::Black::model(const Data & rData, double dInterval, double dQuality,
 		  double dPathDependQuality)
 {
   return cfl::Black::model(rData, dInterval, NBrownian::model(dQuality), 
-			   NExtended::model(dPathDependQuality)); 
+			   NExtended::flat(dPathDependQuality)); 
 }
 
 inline cfl::AssetModel 
@@ -21,5 +21,5 @@ cfl::Black::model(const Data & rData, double dInterval,
 		  const Brownian & rBrownian, const Approx & rApprox)
 {
   return cfl::Black::model(rData, dInterval, rBrownian, 
-			   NExtended::model(rApprox)); 
+			   NExtended::flat(rApprox)); 
 }
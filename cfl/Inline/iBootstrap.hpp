@@ -0,0 +1,11 @@
+//do not include this file
+
+inline std::shared_ptr<const cfl::Bootstrap::Curve> cfl::Bootstrap::curve() const
+{
+  return std::atomic_load(&m_pCurve);
+}
+
+inline unsigned cfl::Bootstrap::numberOfSolved() const
+{
+  return m_iSolved;
+}
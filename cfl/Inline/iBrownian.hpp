@@ -54,6 +54,30 @@ inline void cfl::Brownian::rollback(Slice & rSlice, unsigned iEventTime) const
   rSlice.assign(*this);
 }
 
+inline void cfl::Brownian::rollback(std::vector<Slice> & rSlices, unsigned iEventTime) const
+{
+  for (unsigned iI=0; iI<rSlices.size(); iI++) {
+    rSlices[iI].assign(*m_pBrownian);
+  }
+  m_pBrownian->rollback(rSlices, iEventTime);
+  for (unsigned iI=0; iI<rSlices.size(); iI++) {
+    rSlices[iI].assign(*this);
+  }
+}
+
+inline void cfl::Brownian::rollback(Slice & rSlice, unsigned iEventTime, 
+				   const Slice & rStart, const Slice & rEnd, 
+				   double dLowerBarrier, double dUpperBarrier) const
+{
+  Slice uStart(rStart);
+  uStart.assign(*m_pBrownian);
+  Slice uEnd(rEnd);
+  uEnd.assign(*m_pBrownian);
+  rSlice.assign(*m_pBrownian);
+  m_pBrownian->rollback(rSlice, iEventTime, uStart, uEnd, dLowerBarrier, dUpperBarrier);
+  rSlice.assign(*this);
+}
+
 inline void cfl::Brownian::indicator(Slice & rSlice, double dBarrier) const
 {
   rSlice.assign(*m_pBrownian);
@@ -61,6 +85,18 @@ inline void cfl::Brownian::indicator(Slice & rSlice, double dBarrier) const
   rSlice.assign(*this);
 }
 
+inline std::vector<cfl::Slice> 
+cfl::Brownian::indicator(const Slice & rSlice, const std::vector<double> & rBarriers) const
+{
+  Slice uSlice(rSlice);
+  uSlice.assign(*m_pBrownian);
+  std::vector<Slice> uInd = m_pBrownian->indicator(uSlice, rBarriers); 
+  for (unsigned iK=0; iK<uInd.size(); iK++) {
+    uInd[iK].assign(*this);
+  }
+  return uInd;
+}
+
  	
 inline cfl::MultiFunction cfl::Brownian::interpolate(const Slice & rSlice) const
 {
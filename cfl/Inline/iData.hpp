@@ -1,2 +1,22 @@
 //Copyright (c) Dmitry Kramkov, 2000-2006. All rights reserved. 
 // do not include this file
+
+inline double cfl::Data::Schedule::issueTime() const
+{
+  return m_dIssueTime;
+}
+
+inline const std::vector<double> & cfl::Data::Schedule::paymentTimes() const
+{
+  return m_uTime;
+}
+
+inline const std::vector<double> & cfl::Data::Schedule::accrualPeriods() const
+{
+  return m_uPeriod;
+}
+
+inline const std::vector<double> & cfl::Data::Schedule::payments() const
+{
+  return m_uPayment;
+}
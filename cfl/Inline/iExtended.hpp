@@ -58,6 +58,34 @@ inline void cfl::Extended::rollback(Slice & rSlice, unsigned iEventTime) const
   rSlice.assign(*this);
 }
 
+inline void cfl::Extended::rollback(std::vector<Slice> & rSlices, unsigned iEventTime) const
+{
+  const IModel & rModel = (m_uModels.size()>0) ? *m_uModels.back() : *m_pModel;
+  for (unsigned iI=0; iI<rSlices.size(); iI++) {
+    PRECONDITION(rSlices[iI].ptrToModel() == this);
+    rSlices[iI].assign(rModel);
+  }
+  rModel.rollback(rSlices, iEventTime);
+  for (unsigned iI=0; iI<rSlices.size(); iI++) {
+    rSlices[iI].assign(*this);
+  }
+}
+
+inline void cfl::Extended::rollback(Slice & rSlice, unsigned iEventTime, 
+				   const Slice & rStart, const Slice & rEnd, 
+				   double dLowerBarrier, double dUpperBarrier) const
+{
+  PRECONDITION(rSlice.ptrToModel() == this);
+  const IModel & rModel = (m_uModels.size()>0) ? *m_uModels.back() : *m_pModel;
+  Slice uStart(rStart);
+  uStart.assign(rModel);
+  Slice uEnd(rEnd);
+  uEnd.assign(rModel);
+  rSlice.assign(rModel);
+  rModel.rollback(rSlice, iEventTime, uStart, uEnd, dLowerBarrier, dUpperBarrier);
+  rSlice.assign(*this);
+}
+
 inline void cfl::Extended::indicator(Slice & rSlice, double dBarrier) const
 {
   PRECONDITION(rSlice.ptrToModel() == this);
@@ -67,6 +95,20 @@ inline void cfl::Extended::indicator(Slice & rSlice, double dBarrier) const
   rSlice.assign(*this);
 }
 
+inline std::vector<cfl::Slice> 
+cfl::Extended::indicator(const Slice & rSlice, const std::vector<double> & rBarriers) const
+{
+  PRECONDITION(rSlice.ptrToModel() == this);
+  const IModel & rModel = (m_uModels.size()>0) ? *m_uModels.back() : *m_pModel;
+  Slice uSlice(rSlice);
+  uSlice.assign(rModel);
+  std::vector<Slice> uInd = rModel.indicator(uSlice, rBarriers);
+  for (unsigned iK=0; iK<uInd.size(); iK++) {
+    uInd[iK].assign(*this);
+  }
+  return uInd;
+}
+
 inline cfl::MultiFunction cfl::Extended::interpolate(const Slice & rSlice) const
 {
   PRECONDITION(rSlice.ptrToModel() == this);
@@ -90,3 +132,13 @@ inline cfl::Extended cfl::NExtended::model(double dQuality)
 }
 
 
+
+inline cfl::Extended cfl::NExtended::flat(const Approx & rApprox)
+{
+  return flat(std::vector<Approx>(1, rApprox));
+}
+
+inline cfl::Extended cfl::NExtended::flat(double dQuality)
+{
+  return flat(std::vector<double>(1, dQuality));
+}
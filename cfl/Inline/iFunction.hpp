@@ -10,6 +10,16 @@ inline bool cfl::Function::belongs(double dX) const
   return m_pF->belongs(dX);
 }
 
+inline void cfl::Function::evaluate(const double * pX, double * pY, size_t iSize) const 
+{
+  m_pF->evaluate(pX, pY, iSize);
+}
+
+inline double cfl::Function::tangent(double dX, double * pTangent, unsigned iTangents) const 
+{
+  return m_pF->tangent(dX, pTangent, iTangents);
+}
+
 namespace cflFunction
 {
   template<class F>
@@ -10,3 +10,9 @@ inline void cfl::GaussRollback::rollback(std::valarray<double> & rValues) const
 {
   m_uP->rollback(rValues);
 }
+
+inline void cfl::GaussRollback::rollback(std::valarray<double> & rValues, 
+					 unsigned iColumns) const 
+{
+  m_uP->rollback(rValues, iColumns);
+}
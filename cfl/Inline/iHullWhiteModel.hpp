@@ -6,7 +6,7 @@ cfl::HullWhite::model(const Data & rData,
 		      double dInterval, double dQuality)
 {
   return HullWhite::model(rData, dInterval, NBrownian::model(dQuality),
-			  NExtended::model(dQuality)); 
+			  NExtended::flat(dQuality)); 
 }
 
 inline cfl::InterestRateModel 
@@ -14,7 +14,7 @@ cfl::HullWhite::model(const Data & rData, double dInterval,
 		      double dQuality, double dPathDependQuality) 
 {
   return cfl::HullWhite::model(rData, dInterval, NBrownian::model(dQuality), 
-			       NExtended::model(dPathDependQuality)); 
+			       NExtended::flat(dPathDependQuality)); 
 }
 
 inline cfl::InterestRateModel 
@@ -22,5 +22,5 @@ cfl::HullWhite::model(const Data & rData, double dInterval,
 		      const Brownian & rBrownian, const Approx & rApprox)
 {
   return cfl::HullWhite::model(rData, dInterval, rBrownian, 
-			       NExtended::model(rApprox)); 
+			       NExtended::flat(rApprox)); 
 }
@@ -7,3 +7,11 @@ cfl::Ind::indicator(std::valarray<double> & rValues, double dBarrier) const
   return m_pInd->indicator(rValues, dBarrier);
 }
 
+
+inline void 
+cfl::Ind::indicator(const std::valarray<double> & rValues, 
+		    const std::vector<double> & rBarriers, 
+		    std::valarray<double> & rInd) const 
+{
+  m_pInd->indicator(rValues, rBarriers, rInd);
+}
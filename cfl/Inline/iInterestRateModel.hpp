@@ -5,10 +5,23 @@ cfl::InterestRateModel::assignEventTimes(const std::vector<double> & rEventTimes
 {
   //initial time should be the same 
   PRECONDITION(rEventTimes.front() == eventTimes().front());
-  m_pModel.reset(m_pModel->newModel(rEventTimes));
+  if (rEventTimes != eventTimes()) {
+    m_pModel.reset(m_pModel->newModel(rEventTimes));
+  }
   m_uExtended.assign(*m_pModel);
 }
 
+inline bool 
+cfl::InterestRateModel::addEventTimes(const std::vector<double> & rEventTimes) 
+{
+  std::vector<double> uEventTimes = merge(eventTimes(), rEventTimes);
+  if (uEventTimes.size() == eventTimes().size()) {
+    return false;
+  }
+  assignEventTimes(uEventTimes);
+  return true;
+}
+
 inline unsigned 
 cfl::InterestRateModel::addState(const PathDependent & rState)
 {
@@ -21,6 +34,12 @@ cfl::InterestRateModel::numberOfStates() const
   return m_uExtended.numberOfStates();
 }
 
+inline unsigned 
+cfl::InterestRateModel::numberOfApproxNodes(bool bFixedPolicy) const
+{
+  return m_uExtended.numberOfApproxNodes(bFixedPolicy);
+}
+
 inline const std::vector<double> & 
 cfl::InterestRateModel::eventTimes() const 
 { 
@@ -9,3 +9,27 @@ cfl::Interp::interpolate(InIt1 itArgBegin, InIt1 itArgEnd, InIt2 itValBegin) con
   std::vector<double> uVal(itValBegin, itValBegin + (itArgEnd-itArgBegin));
   return m_uP->interpolate(uArg, uVal);
 }
+
+template <class InIt> 
+inline cfl::Function 
+cfl::Interp::interpolate(const std::shared_ptr<const std::vector<double> > & pArg, 
+			 InIt itValBegin) const 
+{
+  std::vector<double> uVal(itValBegin, itValBegin + pArg->size());
+  return m_uP->interpolate(pArg, uVal);
+}
+
+inline std::vector<cfl::Function> 
+cfl::Interp::interpolate(const std::shared_ptr<const std::vector<double> > & pArg, 
+			 const std::vector<double> & rVal, unsigned iColumns) const
+{
+  PRECONDITION(rVal.size() == pArg->size()*iColumns);
+  return m_uP->interpolate(pArg, rVal, iColumns);
+}
+
+inline double 
+cfl::Interp::value(const std::shared_ptr<const std::vector<double> > & pArg, 
+		   const double * pVal, double dX) const
+{
+  return m_uP->value(pArg, pVal, dX);
+}
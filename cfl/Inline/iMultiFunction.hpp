@@ -10,6 +10,16 @@ inline bool cfl::MultiFunction::belongs(const std::valarray<double> & rX) const
 	return m_pF->belongs(rX); 
 }
 
+inline double cfl::MultiFunction::operator()(const double * pX) const 
+{ 
+	return (*m_pF)(pX); 
+}
+
+inline bool cfl::MultiFunction::belongs(const double * pX) const 
+{
+	return m_pF->belongs(pX); 
+}
+
 inline unsigned cfl::MultiFunction::dim() const 
 { 
 	return m_pF->dim(); 
@@ -0,0 +1,16 @@
+//do not include this file
+
+inline const std::vector<double> & cfl::Trade::eventTimes() const
+{
+  return m_uP->eventTimes();
+}
+
+inline unsigned cfl::Trade::numberOfSlices() const
+{
+  return m_uP->numberOfSlices();
+}
+
+inline void cfl::Trade::event(std::vector<Slice> & rValues, unsigned iEventTime) const
+{
+  m_uP->event(rValues, iEventTime);
+}
@@ -113,6 +113,14 @@ inline void cfl::Slice::assign(const IModel & rModel)
   POSTCONDITION(m_pModel->numberOfNodes(m_iEventTime, m_uDependence) == m_uValues.size());
 }
 
+inline void cfl::Slice::swap(Slice & rSlice) 
+{
+  std::swap(m_pModel, rSlice.m_pModel);
+  std::swap(m_iEventTime, rSlice.m_iEventTime);
+  m_uDependence.swap(rSlice.m_uDependence);
+  m_uValues.swap(rSlice.m_uValues);
+}
+
 //Arithmetic operators and functions. 
 inline cfl::Slice cfl::operator-(const cfl::Slice & rSlice) 
 {
@@ -250,6 +258,12 @@ inline cfl::Slice cfl::indicator(const cfl::Slice & rSlice, const cfl::Slice & r
   return indicator(rSlice-rBarrier, 0.);
 }
 
+inline std::vector<cfl::Slice> 
+cfl::indicator(const cfl::Slice & rSlice, const std::vector<double> & rBarriers) 
+{
+  return rSlice.ptrToModel()->indicator(rSlice, rBarriers);
+}
+
 inline cfl::Slice cfl::rollback(const cfl::Slice & rSlice, unsigned iTime) 
 {
   cfl::Slice uSlice(rSlice);
@@ -257,6 +271,23 @@ inline cfl::Slice cfl::rollback(const cfl::Slice & rSlice, unsigned iTime)
   return uSlice;
 }
 
+inline void cfl::rollback(std::vector<cfl::Slice> & rSlices, unsigned iTime) 
+{
+  if (rSlices.size() > 0) {
+    rSlices.front().ptrToModel()->rollback(rSlices, iTime);
+  }
+}
+
+inline cfl::Slice cfl::rollback(const cfl::Slice & rSlice, unsigned iTime, 
+				const cfl::Slice & rStart, const cfl::Slice & rEnd, 
+				double dLowerBarrier, double dUpperBarrier) 
+{
+  cfl::Slice uSlice(rSlice);
+  rSlice.ptrToModel()->rollback(uSlice, iTime, rStart, rEnd, 
+				dLowerBarrier, dUpperBarrier);
+  return uSlice;
+}
+
 inline cfl::MultiFunction cfl::interpolate(const cfl::Slice & rSlice) 
 {
   return rSlice.ptrToModel()->interpolate(rSlice);
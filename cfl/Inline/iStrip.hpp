@@ -0,0 +1,450 @@
+//do not include this file
+
+inline cfl::Strip & cfl::Strip::operator+=(const Strip & rStrip)
+{
+  PRECONDITION(rStrip.size() == size());
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] += rStrip[iI];
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator-=(const Strip & rStrip)
+{
+  PRECONDITION(rStrip.size() == size());
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] -= rStrip[iI];
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator*=(const Strip & rStrip)
+{
+  PRECONDITION(rStrip.size() == size());
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] *= rStrip[iI];
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator/=(const Strip & rStrip)
+{
+  PRECONDITION(rStrip.size() == size());
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] /= rStrip[iI];
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator+=(const Slice & rSlice)
+{
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] += rSlice;
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator-=(const Slice & rSlice)
+{
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] -= rSlice;
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator*=(const Slice & rSlice)
+{
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] *= rSlice;
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator/=(const Slice & rSlice)
+{
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] /= rSlice;
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator+=(double dValue)
+{
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] += dValue;
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator-=(double dValue)
+{
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] -= dValue;
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator*=(double dValue)
+{
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] *= dValue;
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator/=(double dValue)
+{
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] /= dValue;
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator+=(const std::vector<double> & rValues)
+{
+  PRECONDITION(rValues.size() == size());
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] += rValues[iI];
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator-=(const std::vector<double> & rValues)
+{
+  PRECONDITION(rValues.size() == size());
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] -= rValues[iI];
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator*=(const std::vector<double> & rValues)
+{
+  PRECONDITION(rValues.size() == size());
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] *= rValues[iI];
+  }
+  return *this;
+}
+
+inline cfl::Strip & cfl::Strip::operator/=(const std::vector<double> & rValues)
+{
+  PRECONDITION(rValues.size() == size());
+  for (unsigned iI=0; iI<m_uColumns.size(); iI++) {
+    m_uColumns[iI] /= rValues[iI];
+  }
+  return *this;
+}
+
+inline void cfl::Strip::rollback(unsigned iTime)
+{
+  cfl::rollback(m_uColumns, iTime);
+}
+
+inline unsigned cfl::Strip::size() const
+{
+  return m_uColumns.size();
+}
+
+inline const cfl::Slice & cfl::Strip::operator[](unsigned iColumn) const
+{
+  PRECONDITION(iColumn < size());
+  return m_uColumns[iColumn];
+}
+
+inline cfl::Slice & cfl::Strip::operator[](unsigned iColumn)
+{
+  PRECONDITION(iColumn < size());
+  return m_uColumns[iColumn];
+}
+
+inline const std::vector<cfl::Slice> & cfl::Strip::columns() const
+{
+  return m_uColumns;
+}
+
+inline unsigned cfl::Strip::timeIndex() const
+{
+  return m_uColumns.front().timeIndex();
+}
+
+//Arithmetic operators and functions.
+inline cfl::Strip cfl::operator-(const cfl::Strip & rStrip)
+{
+  return rStrip*(-1.);
+}
+
+inline cfl::Strip cfl::operator+(const cfl::Strip & rStrip1, const cfl::Strip & rStrip2)
+{
+  cfl::Strip uStrip(rStrip1);
+  uStrip += rStrip2;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator-(const cfl::Strip & rStrip1, const cfl::Strip & rStrip2)
+{
+  cfl::Strip uStrip(rStrip1);
+  uStrip -= rStrip2;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator*(const cfl::Strip & rStrip1, const cfl::Strip & rStrip2)
+{
+  cfl::Strip uStrip(rStrip1);
+  uStrip *= rStrip2;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator/(const cfl::Strip & rStrip1, const cfl::Strip & rStrip2)
+{
+  cfl::Strip uStrip(rStrip1);
+  uStrip /= rStrip2;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator+(const cfl::Strip & rStrip, const cfl::Slice & rSlice)
+{
+  cfl::Strip uStrip(rStrip);
+  uStrip += rSlice;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator-(const cfl::Strip & rStrip, const cfl::Slice & rSlice)
+{
+  cfl::Strip uStrip(rStrip);
+  uStrip -= rSlice;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator*(const cfl::Strip & rStrip, const cfl::Slice & rSlice)
+{
+  cfl::Strip uStrip(rStrip);
+  uStrip *= rSlice;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator/(const cfl::Strip & rStrip, const cfl::Slice & rSlice)
+{
+  cfl::Strip uStrip(rStrip);
+  uStrip /= rSlice;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator+(const cfl::Strip & rStrip, double dValue)
+{
+  cfl::Strip uStrip(rStrip);
+  uStrip += dValue;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator-(const cfl::Strip & rStrip, double dValue)
+{
+  cfl::Strip uStrip(rStrip);
+  uStrip -= dValue;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator*(const cfl::Strip & rStrip, double dValue)
+{
+  cfl::Strip uStrip(rStrip);
+  uStrip *= dValue;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator/(const cfl::Strip & rStrip, double dValue)
+{
+  cfl::Strip uStrip(rStrip);
+  uStrip /= dValue;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator+(const cfl::Slice & rSlice, const cfl::Strip & rStrip)
+{
+  return rStrip + rSlice;
+}
+
+inline cfl::Strip cfl::operator-(const cfl::Slice & rSlice, const cfl::Strip & rStrip)
+{
+  cfl::Strip uStrip(rSlice, rStrip.size());
+  uStrip -= rStrip;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator*(const cfl::Slice & rSlice, const cfl::Strip & rStrip)
+{
+  return rStrip * rSlice;
+}
+
+inline cfl::Strip cfl::operator/(const cfl::Slice & rSlice, const cfl::Strip & rStrip)
+{
+  cfl::Strip uStrip(rSlice, rStrip.size());
+  uStrip /= rStrip;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator+(double dValue, const cfl::Strip & rStrip)
+{
+  return rStrip + dValue;
+}
+
+inline cfl::Strip cfl::operator-(double dValue, const cfl::Strip & rStrip)
+{
+  cfl::Strip uStrip(rStrip);
+  for (unsigned iI=0; iI<uStrip.size(); iI++) {
+    uStrip[iI] = dValue - rStrip[iI];
+  }
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator*(double dValue, const cfl::Strip & rStrip)
+{
+  return rStrip * dValue;
+}
+
+inline cfl::Strip cfl::operator/(double dValue, const cfl::Strip & rStrip)
+{
+  cfl::Strip uStrip(rStrip);
+  for (unsigned iI=0; iI<uStrip.size(); iI++) {
+    uStrip[iI] = dValue / rStrip[iI];
+  }
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator+(const cfl::Slice & rSlice, const std::vector<double> & rValues)
+{
+  cfl::Strip uStrip(rSlice, rValues.size());
+  uStrip += rValues;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator-(const cfl::Slice & rSlice, const std::vector<double> & rValues)
+{
+  cfl::Strip uStrip(rSlice, rValues.size());
+  uStrip -= rValues;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator*(const cfl::Slice & rSlice, const std::vector<double> & rValues)
+{
+  cfl::Strip uStrip(rSlice, rValues.size());
+  uStrip *= rValues;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator/(const cfl::Slice & rSlice, const std::vector<double> & rValues)
+{
+  cfl::Strip uStrip(rSlice, rValues.size());
+  uStrip /= rValues;
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator+(const std::vector<double> & rValues, const cfl::Slice & rSlice)
+{
+  return rSlice + rValues;
+}
+
+inline cfl::Strip cfl::operator-(const std::vector<double> & rValues, const cfl::Slice & rSlice)
+{
+  cfl::Strip uStrip(rSlice, rValues.size());
+  for (unsigned iI=0; iI<uStrip.size(); iI++) {
+    uStrip[iI] = rValues[iI] - rSlice;
+  }
+  return uStrip;
+}
+
+inline cfl::Strip cfl::operator*(const std::vector<double> & rValues, const cfl::Slice & rSlice)
+{
+  return rSlice * rValues;
+}
+
+inline cfl::Strip cfl::operator/(const std::vector<double> & rValues, const cfl::Slice & rSlice)
+{
+  cfl::Strip uStrip(rSlice, rValues.size());
+  for (unsigned iI=0; iI<uStrip.size(); iI++) {
+    uStrip[iI] = rValues[iI] / rSlice;
+  }
+  return uStrip;
+}
+
+inline cfl::Strip cfl::max(const cfl::Strip & rStrip1, const cfl::Strip & rStrip2)
+{
+  PRECONDITION(rStrip1.size() == rStrip2.size());
+  cfl::Strip uStrip(rStrip1);
+  for (unsigned iI=0; iI<uStrip.size(); iI++) {
+    uStrip[iI] = max(rStrip1[iI], rStrip2[iI]);
+  }
+  return uStrip;
+}
+
+inline cfl::Strip cfl::max(const cfl::Strip & rStrip, const cfl::Slice & rSlice)
+{
+  cfl::Strip uStrip(rStrip);
+  for (unsigned iI=0; iI<uStrip.size(); iI++) {
+    uStrip[iI] = max(rStrip[iI], rSlice);
+  }
+  return uStrip;
+}
+
+inline cfl::Strip cfl::max(const cfl::Slice & rSlice, const cfl::Strip & rStrip)
+{
+  return max(rStrip, rSlice);
+}
+
+inline cfl::Strip cfl::max(const cfl::Strip & rStrip, double dValue)
+{
+  cfl::Strip uStrip(rStrip);
+  for (unsigned iI=0; iI<uStrip.size(); iI++) {
+    uStrip[iI] = max(rStrip[iI], dValue);
+  }
+  return uStrip;
+}
+
+inline cfl::Strip cfl::max(double dValue, const cfl::Strip & rStrip)
+{
+  return max(rStrip, dValue);
+}
+
+inline cfl::Strip cfl::min(const cfl::Strip & rStrip1, const cfl::Strip & rStrip2)
+{
+  PRECONDITION(rStrip1.size() == rStrip2.size());
+  cfl::Strip uStrip(rStrip1);
+  for (unsigned iI=0; iI<uStrip.size(); iI++) {
+    uStrip[iI] = min(rStrip1[iI], rStrip2[iI]);
+  }
+  return uStrip;
+}
+
+inline cfl::Strip cfl::min(const cfl::Strip & rStrip, const cfl::Slice & rSlice)
+{
+  cfl::Strip uStrip(rStrip);
+  for (unsigned iI=0; iI<uStrip.size(); iI++) {
+    uStrip[iI] = min(rStrip[iI], rSlice);
+  }
+  return uStrip;
+}
+
+inline cfl::Strip cfl::min(const cfl::Slice & rSlice, const cfl::Strip & rStrip)
+{
+  return min(rStrip, rSlice);
+}
+
+inline cfl::Strip cfl::min(const cfl::Strip & rStrip, double dValue)
+{
+  cfl::Strip uStrip(rStrip);
+  for (unsigned iI=0; iI<uStrip.size(); iI++) {
+    uStrip[iI] = min(rStrip[iI], dValue);
+  }
+  return uStrip;
+}
+
+inline cfl::Strip cfl::min(double dValue, const cfl::Strip & rStrip)
+{
+  return min(rStrip, dValue);
+}
+
+inline cfl::Strip cfl::rollback(const cfl::Strip & rStrip, unsigned iTime)
+{
+  cfl::Strip uStrip(rStrip);
+  uStrip.rollback(iTime);
+  return uStrip;
+}
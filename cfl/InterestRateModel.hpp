@@ -5,6 +5,7 @@
 
 #include <valarray>
 #include "cfl/Extended.hpp"
+#include "cfl/Data.hpp"
 
 /**
  * \file   InterestRateModel.hpp
@@ -55,6 +56,20 @@ namespace cfl
      * \return Discount factor with maturity \a dBondMaturity at event time with index \a iEventTime. 
      */
     virtual Slice discount(unsigned iEventTime, double dBondMaturity) const = 0; 
+
+    /** 
+     * Constructs the value at event time with index \a iEventTime of
+     * the payments \a rAmounts at the maturities \a rMaturities. The
+     * default implementation adds up the discount factors one by
+     * one; the models should override it to compute the sum in one
+     * pass over the nodes.
+     * \param iEventTime Index of event time where the value is constructed. 
+     * \param rMaturities The payment times. 
+     * \param rAmounts The payments.
+     * \return The value of the payments at event time with index \a iEventTime. 
+     */
+    virtual Slice discount(unsigned iEventTime, const std::vector<double> & rMaturities,
+			   const std::vector<double> & rAmounts) const; 
   }; 
  
   //! Concrete class for interest rate models. 
@@ -80,9 +95,24 @@ namespace cfl
      * InterestRateModel::addState will be deleted. 
      * \param rEventTimes The new vector of event times for the model. The front element of this 
      * vector should equal the initial time of the model. Otherwise, an error is thrown. 
+     * If \a rEventTimes coincide with the current event times, then the 
+     * implementation of the model and its caches are kept. 
      */
     void assignEventTimes(const std::vector<double> & rEventTimes);
 
+    /** 
+     * Adds the times \a rEventTimes to the event times of the model. 
+     * If all of them are already event times, then the model, its 
+     * caches, and the state processes are kept. Otherwise, the
+     * function is equivalent to 
+     * <code>assignEventTimes(merge(eventTimes(), rEventTimes))</code>. 
+     * The indexes of the times in the new event times are given by 
+     * the function eventIndexes. 
+     * \param rEventTimes The additional event times (in increasing order). 
+     * \return \p true if the event times have changed. 
+     */
+    bool addEventTimes(const std::vector<double> & rEventTimes);
+
     /**
      * \copydoc Extended::addState
      */
@@ -93,6 +123,11 @@ namespace cfl
      */ 
     unsigned numberOfStates() const;
 
+    /**
+     * \copydoc Extended::numberOfApproxNodes
+     */ 
+    unsigned numberOfApproxNodes(bool bFixedPolicy = false) const;
+
     /**
      * \copydoc IModel::eventTimes
      */
@@ -126,6 +161,22 @@ namespace cfl
      */
     Slice discount(unsigned iEventTime, double dBondMaturity) const;
 
+    /**
+     * \copydoc IInterestRateModel::discount(unsigned, const std::vector<double> &, const std::vector<double> &) const
+     */
+    Slice discount(unsigned iEventTime, const std::vector<double> & rMaturities,
+		   const std::vector<double> & rAmounts) const;
+
+    /**
+     * Constructs the value at event time with index \a iEventTime of
+     * the payments of \a rSchedule which take place after this time.
+     * \param iEventTime Index of event time. 
+     * \param rSchedule The payment schedule.
+     * \return The value of the remaining payments of \a rSchedule at
+     * event time with index \a iEventTime.
+     */
+    Slice value(unsigned iEventTime, const Data::Schedule & rSchedule) const;
+
   private:
     Extended m_uExtended; 
     std::shared_ptr<IInterestRateModel> m_pModel;
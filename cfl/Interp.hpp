@@ -46,6 +46,50 @@ namespace cfl
      */
     virtual Function interpolate(const std::vector<double> & rArg, 
 				 const std::vector<double> & rVal) const = 0;
+
+    /**
+     * Interpolation of the data supplied by the shared vector of
+     * arguments (\a pArg) and the vector of values (\a rVal). The
+     * vector of arguments is not copied; it is shared by all
+     * functions interpolated on the same grid. The default
+     * implementation calls the version with copied arguments.
+     * \param pArg The shared pointer to the constant vector of arguments.
+     * \param rVal The vector of values. 
+     * \return Interpolating function. 
+     */
+    virtual Function interpolate(const std::shared_ptr<const std::vector<double> > & pArg, 
+				 const std::vector<double> & rVal) const;
+
+    /**
+     * Interpolation of several functions on the same shared grid of
+     * arguments. The values are stored row by row in a matrix with
+     * \a iColumns columns, one column for every function. The
+     * default implementation interpolates the columns one by one.
+     * \param pArg The shared pointer to the constant vector of arguments.
+     * \param rVal The matrix of values. Its row \p j contains the
+     * values of the functions at the argument \p (*pArg)[j].
+     * \param iColumns The number of functions. 
+     * \return The vector of interpolating functions. 
+     */
+    virtual std::vector<Function> 
+    interpolate(const std::shared_ptr<const std::vector<double> > & pArg, 
+		const std::vector<double> & rVal, unsigned iColumns) const;
+
+    /**
+     * Evaluates at the point \a dX the function interpolated on the
+     * shared grid of arguments \a pArg. The default implementation
+     * constructs the interpolating function. The linear interpolation
+     * and NInterp::fastSpline() evaluate it directly from the values;
+     * for grids of moderate size they do not allocate memory on the
+     * heap.
+     * \param pArg The shared pointer to the constant vector of arguments.
+     * \param pVal The pointer to the values: \p pVal[j] is the value
+     * at the argument \p (*pArg)[j].
+     * \param dX The argument. It should belong to the grid interval.
+     * \return The value of the interpolating function at \a dX.
+     */
+    virtual double value(const std::shared_ptr<const std::vector<double> > & pArg, 
+			 const double * pVal, double dX) const;
   };
 
   //! Standard concrete class for interpolation of one-dimensional functions. 
@@ -76,6 +120,31 @@ namespace cfl
     template <class InIt1, class InIt2> 
     Function interpolate(InIt1 itArgBegin, InIt1 itArgEnd, 
 			 InIt2 itValBegin) const;
+
+    /**
+     * Returns interpolated function for the shared grid of arguments
+     * and given values. Only the values are copied. 
+     * \param pArg The shared pointer to the constant vector of arguments.
+     * \param itValBegin The iterator to the first element of the 
+     * sequence of values
+     * \return Interpolating function.
+     */
+    template <class InIt> 
+    Function interpolate(const std::shared_ptr<const std::vector<double> > & pArg, 
+			 InIt itValBegin) const;
+
+    /**
+     * \copydoc IInterp::interpolate(const std::shared_ptr<const std::vector<double> > &, const std::vector<double> &, unsigned) const
+     */
+    std::vector<Function> 
+    interpolate(const std::shared_ptr<const std::vector<double> > & pArg, 
+		const std::vector<double> & rVal, unsigned iColumns) const;
+
+    /**
+     * \copydoc IInterp::value
+     */
+    double value(const std::shared_ptr<const std::vector<double> > & pArg, 
+		 const double * pVal, double dX) const;
   private:
     std::shared_ptr<IInterp> m_uP;
   };
@@ -99,7 +168,55 @@ namespace cfl
      * \return Class Interp that corresponds to natural cubic spline. 
      */ 
     Interp spline(); 
+
+    /** 
+     * Constructs natural cubic spline interpolation scheme that
+     * factors the tridiagonal system of a grid of arguments once and
+     * reuses it for all functions interpolated on the same grid. The
+     * results coincide with those of spline(). 
+     * \return Class Interp that corresponds to natural cubic spline
+     * with a reusable basis. 
+     */ 
+    Interp fastSpline(); 
   }
+
+  /**
+   * Tabulates the function \a rF on the interval [\a dLeft, \a
+   * dRight]. The interval is split into \a iCells equal cells and
+   * every cell is refined by halving until cubic interpolation of \a
+   * rF on the pieces meets the tolerance: the error at the test
+   * points does not exceed <code>dTolerance*max(1,|rF|)</code>. The
+   * result is stored in flat arrays and the piece containing an
+   * argument is found in constant time. Use it for curves that are
+   * evaluated often and are expensive per call. The result does not
+   * keep the parameters introduced by cfl::seed. A cell is split
+   * into at most 4096 pieces; if the tolerance is not met at this
+   * level, for example, near a kink or a singularity of \a rF, then
+   * NError::range is thrown.
+   * \param rF The function to tabulate. 
+   * \param dLeft The left point of the domain of the result. 
+   * \param dRight The right point of the domain of the result. 
+   * \param dTolerance The tolerance of approximation.
+   * \param iCells The number of initial cells. 
+   * \return The tabulated version of \a rF on [\a dLeft, \a dRight]. 
+   */
+  Function tabulate(const Function & rF, double dLeft, double dRight, 
+		    double dTolerance, unsigned iCells = 32);
+
+  /**
+   * Returns the function interpolated by \a rInterp, where the
+   * values \a rVal are the parameters with the indexes \a iFirst,
+   * ..., \a iFirst + rVal.size() - 1. The derivatives with respect
+   * to these parameters are returned by Function::tangent for all
+   * functions built from the result. \see cfl::seed
+   * \param rInterp The interpolation scheme.
+   * \param rArg The arguments (in increasing order).
+   * \param rVal The values of the function at \a rArg.
+   * \param iFirst The index of the first parameter.
+   * \return The interpolated function with the parameters.
+   */
+  Function seed(const Interp & rInterp, const std::vector<double> & rArg, 
+		const std::vector<double> & rVal, unsigned iFirst = 0);
   //@}
 }
 
@@ -3,6 +3,7 @@
 #ifndef __cflModel_hpp__
 #define __cflModel_hpp__
 
+#include <vector>
 #include "cfl/MultiFunction.hpp"
 
 /**
@@ -105,6 +106,43 @@ namespace cfl
     virtual void rollback(Slice & rSlice, unsigned iEventTime) const = 0;
 
     /** 
+     * "Rolls back" all elements of \a rSlices to the event time
+     * with index \a iEventTime. Implementations should roll back the
+     * slices with the same event time as one multi-column operation.
+     * The default implementation calls rollback(Slice &, unsigned) const
+     * for every slice.
+     * \param rSlices The values of financial securities defined on
+     * \p *this at event times with indexes larger or equal \a
+     * iEventTime. After the operator they are defined at the event time
+     * with index \a iEventTime.
+     * \param iEventTime The index of the "target" event time. 
+     */
+    virtual void rollback(std::vector<Slice> & rSlices, unsigned iEventTime) const;
+
+    /**
+     * "Rolls back" \a rSlice to the event time with index \a
+     * iEventTime under the condition that the underlying random
+     * variable stays between the barriers \a dLowerBarrier and \a
+     * dUpperBarrier continuously in time. Implementations should
+     * account for the crossings of the barriers between the event
+     * times. The default implementation monitors the barriers only at
+     * the initial and the target event times.
+     * \param rSlice Before the operator this object represents the
+     * payoff of a financial security. After the operator it equals the
+     * value at the event time with index \a iEventTime of the security
+     * that pays this payoff if the underlying has not crossed the
+     * barriers and pays nothing otherwise.
+     * \param iEventTime The index of the "target" event time for \a rSlice.
+     * \param rStart The underlying at the event time with index \a iEventTime.
+     * \param rEnd The underlying at the event time of \a rSlice.
+     * \param dLowerBarrier The lower barrier. It can be minus infinity.
+     * \param dUpperBarrier The upper barrier. It can be infinity.
+     */
+    virtual void rollback(Slice & rSlice, unsigned iEventTime,
+			  const Slice & rStart, const Slice & rEnd,
+			  double dLowerBarrier, double dUpperBarrier) const;
+
+    /**
      * Transforms \a rSlice into the indicator function of the event 
      * that the random variable represented by \a rSlice is greater than the barrier 
      * \a dBarrier. 
@@ -115,6 +153,18 @@ namespace cfl
      */
     virtual void indicator(Slice & rSlice, double dBarrier) const = 0;
 
+    /** 
+     * Computes the indicator functions of the events that the random
+     * variable represented by \a rSlice is greater than the barriers
+     * \a rBarriers. The default implementation calls
+     * indicator(Slice &, double) const for every barrier.
+     * \param rSlice A random variable in the model. 
+     * \param rBarriers The values of the barriers. 
+     * \return The vector of indicators, one for every barrier.
+     */
+    virtual std::vector<Slice> indicator(const Slice & rSlice, 
+					 const std::vector<double> & rBarriers) const;
+
     /** 
      * This function explicitly defines the dependence of the given Slice object 
      * on the state processes. The dimension of the returned MultiFunction object 
@@ -125,6 +175,28 @@ namespace cfl
      */		
     virtual MultiFunction interpolate(const Slice & rSlice) const = 0;
   };
+
+  /** 
+   * Merges two vectors of event times. It is used to build one model
+   * for the union of the event times of several derivatives. 
+   * \param rTimes1 The first vector of times (in increasing order). 
+   * \param rTimes2 The second vector of times (in increasing order).
+   * \return The union of \a rTimes1 and \a rTimes2 in increasing
+   * order and without repetitions. 
+   */
+  std::vector<double> merge(const std::vector<double> & rTimes1, 
+			    const std::vector<double> & rTimes2);
+
+  /** 
+   * Finds the indexes of the times \a rTimes in the vector of event
+   * times \a rEventTimes. An error is thrown if some of the times is
+   * not an event time. 
+   * \param rEventTimes The event times of a model (in increasing order). 
+   * \param rTimes The times to be found. 
+   * \return The indexes of the elements of \a rTimes in \a rEventTimes. 
+   */
+  std::vector<unsigned> eventIndexes(const std::vector<double> & rEventTimes, 
+				     const std::vector<double> & rTimes);
   //@}
 }
 
@@ -61,6 +61,30 @@ namespace cfl
      * function and \p false otherwise.
      */
     virtual bool belongs(const std::valarray<double> & rX) const = 0;
+
+    /**
+     * Returns the value of the function at the point given by the
+     * array \a pX of the size dim(). The default implementation
+     * copies the argument into a valarray; the implementations in
+     * the library evaluate without allocations.
+     *  
+     * \param pX The pointer to the first coordinate of the argument.
+     * 
+     * \return The value of the function at \a pX. 
+     */
+    virtual double operator()(const double * pX) const;
+
+    /**
+     * Returns \p true if the point given by the array \a pX of the
+     * size dim() belongs to the domain of the function. Returns \p
+     * false otherwise.
+     *  
+     * \param pX The pointer to the first coordinate of the argument.
+     * 
+     * \return \p True if \a pX belongs to the domain of the
+     * function and \p false otherwise.
+     */
+    virtual bool belongs(const double * pX) const;
 		
     /** 
      * Returns the dimension of the function.
@@ -123,6 +147,16 @@ namespace cfl
      */
     bool belongs(const std::valarray<double> & rX) const;
 
+    /**
+     * \copydoc IMultiFunction::operator()(const double *) const
+     */
+    double operator()(const double * pX) const;
+
+    /**
+     * \copydoc IMultiFunction::belongs(const double *) const
+     */
+    bool belongs(const double * pX) const;
+
     /**
      * \copydoc IMultiFunction::dim
      */
@@ -0,0 +1,175 @@
+#ifndef __cflPortfolio_hpp__
+#define __cflPortfolio_hpp__
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "cfl/AssetModel.hpp"
+#include "cfl/InterestRateModel.hpp"
+
+/**
+ * \file   Portfolio.hpp
+ *
+ * \brief Pricing of many trades in one backward induction.
+ *
+ * This file contains the classes for trades given by their event
+ * times and the actions at these times, and the functions that price
+ * a portfolio of such trades in one backward sweep of a model.
+ */
+
+namespace cfl
+{
+  /**
+   * \ingroup cflCommonElements
+   * \defgroup cflPortfolio Portfolios of trades.
+   * This module prices many trades on a common grid of event times.
+   * The values of all live trades are rolled back together, so a
+   * portfolio costs about as much as one multi-column rollback.
+   */
+  //@{
+
+  //! Interface class for a trade in a portfolio.
+  /**
+   * A trade is described by its event times and by the action
+   * (exercise, barrier, payment) at every event time. Its value is
+   * given by one or several slices; the price of the trade is the
+   * first of them. Its implementation on a free store is used to
+   * construct the concrete class Trade.
+   * \see Trade
+   */
+  class ITrade
+  {
+  public:
+    /**
+     * Virtual destructor.
+     */
+    virtual ~ITrade(){}
+
+    /**
+     * Returns the event times of the trade in increasing order.
+     * \return The event times of the trade.
+     */
+    virtual const std::vector<double> & eventTimes() const = 0;
+
+    /**
+     * Returns the number of slices that describe the value of the
+     * trade, for example, the number of exercises of a swing option.
+     * \return The number of slices.
+     */
+    virtual unsigned numberOfSlices() const = 0;
+
+    /**
+     * Performs the action of the trade at an event time.
+     * \param rValues \em Before the operation these are the values of
+     * the trade immediately after the event time. At the last event
+     * time of the trade they equal zero. \em After the operation they
+     * are the values immediately before the event time.
+     * \param iEventTime The index of the event time in the model.
+     */
+    virtual void event(std::vector<Slice> & rValues, unsigned iEventTime) const = 0;
+  };
+
+  //! Concrete class for a trade in a portfolio.
+  /**
+   * This class is implemented by a dynamically allocated
+   * implementation of the interface class ITrade.
+   * \see ITrade
+   */
+  class Trade
+  {
+  public:
+    /**
+     * Constructs \p *this from a dynamically allocated
+     * implementation of the interface class ITrade.
+     * \param pNewP A pointer to a dynamically allocated
+     * implementation of ITrade.
+     */
+    explicit Trade(ITrade * pNewP = 0);
+
+    /**
+     * \copydoc ITrade::eventTimes
+     */
+    const std::vector<double> & eventTimes() const;
+
+    /**
+     * \copydoc ITrade::numberOfSlices
+     */
+    unsigned numberOfSlices() const;
+
+    /**
+     * \copydoc ITrade::event
+     */
+    void event(std::vector<Slice> & rValues, unsigned iEventTime) const;
+
+  private:
+    std::shared_ptr<ITrade> m_uP;
+  };
+
+  /**
+   * Constructs a trade which value is given by one slice.
+   * \param rEventTimes The event times of the trade.
+   * \param rEvent The action of the trade at an event time. Its
+   * arguments are the value of the trade and the index of the event
+   * time in the model.
+   * \return The trade with event times \a rEventTimes and the
+   * action \a rEvent.
+   */
+  Trade toTrade(const std::vector<double> & rEventTimes,
+		const std::function<void(Slice &, unsigned)> & rEvent);
+
+  /**
+   * Constructs a trade which value is given by several slices.
+   * \param rEventTimes The event times of the trade.
+   * \param iSlices The number of slices.
+   * \param rEvent The action of the trade at an event time. Its
+   * arguments are the values of the trade and the index of the event
+   * time in the model.
+   * \return The trade with event times \a rEventTimes and the
+   * action \a rEvent.
+   */
+  Trade toTrade(const std::vector<double> & rEventTimes, unsigned iSlices,
+		const std::function<void(std::vector<Slice> &, unsigned)> & rEvent);
+
+  /**
+   * Returns the event times for the portfolio \a rTrades: the
+   * initial time and the event times of all trades.
+   * \param rTrades The trades of the portfolio.
+   * \param dInitialTime The initial time.
+   * \return The union of the event times in increasing order.
+   */
+  std::vector<double> eventTimes(const std::vector<Trade> & rTrades,
+				 double dInitialTime);
+
+  /**
+   * Computes the prices of the trades \a rTrades in one backward
+   * induction. The event times of \a rModel are the initial time and
+   * the event times of the trades. The actions of the trades refer
+   * to \a rModel by the indexes of these event times.
+   * \param rTrades The trades of the portfolio.
+   * \param rModel The model.
+   * \return The prices of the trades.
+   */
+  std::vector<MultiFunction> price(const std::vector<Trade> & rTrades,
+				   AssetModel & rModel);
+
+  /**
+   * \copydoc price(const std::vector<Trade> &, AssetModel &)
+   */
+  std::vector<MultiFunction> price(const std::vector<Trade> & rTrades,
+				   InterestRateModel & rModel);
+
+  /**
+   * Computes the values of the trades \a rTrades at the initial time
+   * in one backward induction on the event times of the model of \a
+   * rZero. The values of all live trades are rolled back together.
+   * \param rTrades The trades of the portfolio. Their event times
+   * should be the event times of the model.
+   * \param rZero The zero slice in the model.
+   * \return The values of the trades at the initial time.
+   */
+  std::vector<Slice> sweep(const std::vector<Trade> & rTrades, const Slice & rZero);
+  //@}
+}
+
+#include "cfl/Inline/iPortfolio.hpp"
+#endif // of __cflPortfolio_hpp__
@@ -4,6 +4,7 @@
 #define __cflSlice_hpp__
 
 #include <algorithm>
+#include <utility>
 #include "cfl/Model.hpp"
 #include "cfl/Error.hpp"
 
@@ -233,6 +234,13 @@ namespace cfl
      */
     void assign(const IModel & rModel);
 
+    /** 
+     * Exchanges \p *this and \a rSlice. The arrays of values are
+     * not copied.
+     * \param rSlice The object that is exchanged with \p *this.
+     */
+    void swap(Slice & rSlice);
+
   private:
     const IModel * m_pModel;
     unsigned m_iEventTime;
@@ -468,6 +476,16 @@ namespace cfl
    */
   Slice indicator(const Slice & rSlice, const Slice & rBarrier);
 
+  /** 
+   * Returns the indicators of the events: \a rSlice is greater than
+   * the barriers \a rBarriers. All indicators are computed in one
+   * call to the model. 
+   * \param rSlice The random variable. 
+   * \param rBarriers The values of the barriers. 
+   * \return The vector of indicators, one for every barrier. 
+   */
+  std::vector<Slice> indicator(const Slice & rSlice, const std::vector<double> & rBarriers);
+
   /** 
    * Returns the equivalent value of the derivative security 
    * represented by \a rSlice at event time with index \a iEventTime. 
@@ -481,6 +499,45 @@ namespace cfl
    */
   Slice rollback(const Slice & rSlice, unsigned iEventTime);
 
+  /** 
+   * Replaces the elements of \a rSlices with their equivalent values
+   * at event time with index \a iEventTime. The slices should be
+   * defined on the same model; those with the same event time are
+   * rolled back together. 
+   * \param rSlices Random payoffs at event times with indexes greater
+   * or equal \a iEventTime. 
+   * \param iEventTime Index of the target event time. 
+   * \see IModel::rollback(std::vector<Slice> &, unsigned) const
+   */
+  void rollback(std::vector<Slice> & rSlices, unsigned iEventTime);
+
+  /** 
+   * Returns the value at event time with index \a iEventTime of the
+   * payoff \a rSlice which is paid only if the underlying stays
+   * between the barriers \a dLowerBarrier and \a dUpperBarrier
+   * continuously in time. The crossings of the barriers between the
+   * event times are accounted for by the model; hence continuously
+   * monitored barriers do not need event times in between. For
+   * discretely monitored barriers use the continuity correction, for
+   * example, Black::continuousBarrier(). If \a rSlice, \a rStart or
+   * \a rEnd depends on the path dependent states added by
+   * AssetModel::addState or InterestRateModel::addState, then the
+   * barriers are monitored only at the two event times and the event
+   * times in between are needed as for discrete monitoring.
+   * \param rSlice A random payoff. 
+   * \param iEventTime Index of the target event time. 
+   * \param rStart The underlying at the event time with index \a iEventTime. 
+   * \param rEnd The underlying at the event time of \a rSlice. 
+   * \param dLowerBarrier The lower barrier. It can be minus infinity. 
+   * \param dUpperBarrier The upper barrier. It can be infinity. 
+   * \return The price of the knock-out payoff at the event time with
+   * the index \a iEventTime. 
+   * \see IModel::rollback(Slice &, unsigned, const Slice &, const Slice &, double, double) const
+   */
+  Slice rollback(const Slice & rSlice, unsigned iEventTime, 
+		 const Slice & rStart, const Slice & rEnd, 
+		 double dLowerBarrier, double dUpperBarrier);
+
   /**
    * \copydoc IModel::interpolate
    */
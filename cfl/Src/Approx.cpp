@@ -12,6 +12,24 @@
 using namespace cfl;
 const double c_dPi = ::acos(-1.);
 
+// CLASS IApprox
+
+void cfl::IApprox::approximate(const double * pValues, unsigned iColumns, 
+			       const double * pArg, unsigned iPoints, 
+			       double * pResult) const
+{
+  std::valarray<double> uValues(arg().size());
+  for (unsigned iJ=0; iJ<iColumns; iJ++) {
+    for (unsigned iI=0; iI<uValues.size(); iI++) {
+      uValues[iI] = pValues[iI*iColumns + iJ];
+    }
+    Function uApprox = approximate(uValues);
+    for (unsigned iM=0; iM<iPoints; iM++) {
+      pResult[iM*iColumns + iJ] = uApprox(pArg[iM*iColumns + iJ]);
+    }
+  }
+}
+
 // CLASS Approx
 
 cfl::Approx::Approx(IApprox * pNewP)
@@ -20,28 +38,43 @@ cfl::Approx::Approx(IApprox * pNewP)
 
 namespace cflApprox
 {
+  //Coefficients of Chebyshev approximation for iColumns functions
+  //with the values pValues at iN nodes (row by row); rCos is the table
+  //of cosines cos(pi*i*(k+0.5)/n) and the nodes are in increasing
+  //order.
+  void chebyshevCoeff(const std::valarray<double> & rCos, unsigned iN, 
+		      const double * pValues, unsigned iColumns, double * pCoeff)
+  {
+    PRECONDITION(rCos.size() == iN*iN);
+    std::fill(pCoeff, pCoeff + iN*iColumns, 0.);
+    for (unsigned iI=0; iI<iN; iI++) {
+      double * pC = pCoeff + iI*iColumns;
+      for (unsigned iK=0; iK<iN; iK++) {
+	double dCos = rCos[iI*iN + iK];
+	const double * pV = pValues + (iN-1-iK)*iColumns;
+	for (unsigned iJ=0; iJ<iColumns; iJ++) {
+	  pC[iJ] += pV[iJ]*dCos;
+	}
+      }
+    }
+    double dFac = 2.0/iN;
+    std::transform(pCoeff, pCoeff + iN*iColumns, pCoeff, 
+		   [dFac](double dC) { return dFac*dC; });
+  }
+
   // CLASS ChebyshevApprox 
 
   class ChebyshevApprox: public IFunction
   {
   public:
-    ChebyshevApprox(const std::valarray<double> & rArg, 
+    ChebyshevApprox(const std::valarray<double> & rCos, 
 		    const std::valarray<double> & rValues, 
 		    double dLeft, double dRight)
-      :m_uValues(rValues), m_uArg(rArg), m_uCoeff(m_uArg.size()), 
-       m_dL(dLeft), m_dR(dRight)
+      :m_uCoeff(rValues.size()), m_dL(dLeft), m_dR(dRight)
     {
       PRECONDITION(m_dL <= m_dR);
-      PRECONDITION(m_uArg.size()>0);
-      double dFac=2.0/m_uArg.size();
-      for (unsigned int iI=0;iI<m_uArg.size();iI++) {
-	double dSum=0.0;
-	for (unsigned int iK=0;iK<m_uArg.size();iK++) {
-	  dSum += rValues[rValues.size()-1-iK]* 
-	    cos(c_dPi*iI*(iK+0.5)/m_uArg.size()); 
-	}
-	m_uCoeff[iI]=dFac*dSum;		
-      }
+      PRECONDITION(m_uCoeff.size()>0);
+      chebyshevCoeff(rCos, m_uCoeff.size(), &rValues[0], 1, &m_uCoeff[0]);
     }
 
     bool belongs(double dX) const 
@@ -52,26 +85,31 @@ namespace cflApprox
     double operator()(double dT) const 
     {
       ASSERT((dT>=m_dL)&&(dT<=m_dR));
-      double dRes = 0.5*m_uCoeff[0];
-      if (m_uArg.size()>1) {
-	double a = 0.5*(m_dR-m_dL);
-	double b = 0.5*(m_dR+m_dL);
-	double dX = (dT-b)/a;
-	double dA = 1.; //T_{n-2}(x)
-	double dB = dX; //T_{n-1}(x)
-	dRes += dB*m_uCoeff[1];
-	double dC = 0.;
-	for (unsigned int iI=2;iI<m_uCoeff.size();iI++) {
-	  dC = 2.*dX*dB - dA; //T_n(x)
-	  dRes += dC*m_uCoeff[iI];
-	  dA = dB;
-	  dB = dC;
-	}
+      if (m_uCoeff.size() == 1) {
+	return 0.5*m_uCoeff[0];
+      }
+      double dA = 0.5*(m_dR-m_dL);
+      double dB = 0.5*(m_dR+m_dL);
+      double dX = (dT-dB)/dA;
+      //Clenshaw recurrence
+      double dB1 = 0.; 
+      double dB2 = 0.;
+      for (unsigned iI=m_uCoeff.size()-1; iI>0; iI--) {
+	double dC = 2.*dX*dB1 - dB2 + m_uCoeff[iI];
+	dB2 = dB1;
+	dB1 = dC;
+      }
+      return dX*dB1 - dB2 + 0.5*m_uCoeff[0];
+    }
+
+    void evaluate(const double * pX, double * pY, size_t iSize) const 
+    {
+      for (size_t iI=0; iI<iSize; iI++) {
+	pY[iI] = ChebyshevApprox::operator()(pX[iI]);
       }
-      return dRes;
     }
   private:
-    std::valarray<double> m_uValues, m_uArg, m_uCoeff;
+    std::valarray<double> m_uCoeff;
     double m_dL, m_dR;
   };
 	
@@ -97,6 +135,15 @@ namespace cflApprox
 	}
 	POSTCONDITION(std::equal(&m_uArg[1], &m_uArg[m_uArg.size()], &m_uArg[0], 
 				 std::greater<double>()));
+	//the table of cosines is shared by all approximations on the grid
+	unsigned iN = m_uArg.size();
+	std::valarray<double> uCos(iN*iN);
+	for (unsigned iI=0; iI<iN; iI++) {
+	  for (unsigned iK=0; iK<iN; iK++) {
+	    uCos[iI*iN + iK] = cos(c_dPi*iI*(iK+0.5)/iN);
+	  }
+	}
+	m_pCos.reset(new std::valarray<double>(uCos));
       }
       else {
 	ASSERT(m_uArg.size() == 1);
@@ -121,13 +168,60 @@ namespace cflApprox
 	return cfl::Function(rValues[0], m_dL, m_dR);
       }
       else { 
-	return Function(new cflApprox::ChebyshevApprox(m_uArg, rValues, m_dL, m_dR)); 
+	return Function(new cflApprox::ChebyshevApprox(*m_pCos, rValues, m_dL, m_dR)); 
       }
     }		
+
+    void approximate(const double * pValues, unsigned iColumns, 
+		     const double * pArg, unsigned iPoints, double * pResult) const
+    {
+      unsigned iN = m_uArg.size();
+      if (iN == 1) {
+	for (unsigned iM=0; iM<iPoints; iM++) {
+	  std::copy(pValues, pValues + iColumns, pResult + iM*iColumns);
+	}
+	return;
+      }
+      //the coefficients and the work arrays of the Clenshaw recurrence
+      Scratch<c_iScratch> uScratch(iN*iColumns + 3*iColumns);
+      double * uCoeff = uScratch.begin();
+      double * uX = uCoeff + iN*iColumns;
+      double * uB1 = uX + iColumns;
+      double * uB2 = uB1 + iColumns;
+      chebyshevCoeff(*m_pCos, iN, pValues, iColumns, uCoeff);
+
+      //Clenshaw recurrence for all columns at once
+      double dA = 0.5*(m_dR-m_dL);
+      double dB = 0.5*(m_dR+m_dL);
+      for (unsigned iM=0; iM<iPoints; iM++) {
+	const double * pX = pArg + iM*iColumns;
+	for (unsigned iJ=0; iJ<iColumns; iJ++) {
+	  ASSERT((pX[iJ] >= m_dL) && (pX[iJ] <= m_dR));
+	  uX[iJ] = (pX[iJ] - dB)/dA;
+	}
+	std::fill(uB1, uB1 + iColumns, 0.);
+	std::fill(uB2, uB2 + iColumns, 0.);
+	for (unsigned iI=iN-1; iI>0; iI--) {
+	  const double * pC = uCoeff + iI*iColumns;
+	  for (unsigned iJ=0; iJ<iColumns; iJ++) {
+	    double dC = 2.*uX[iJ]*uB1[iJ] - uB2[iJ] + pC[iJ];
+	    uB2[iJ] = uB1[iJ];
+	    uB1[iJ] = dC;
+	  }
+	}
+	double * pR = pResult + iM*iColumns;
+	for (unsigned iJ=0; iJ<iColumns; iJ++) {
+	  pR[iJ] = uX[iJ]*uB1[iJ] - uB2[iJ] + 0.5*uCoeff[iJ];
+	}
+      }
+    }
+
   private:
     std::valarray<double> m_uArg;
     Function m_uSize;
     double m_dL, m_dR;
+    std::shared_ptr<const std::valarray<double> > m_pCos;
+    static const unsigned c_iScratch = 256;
   };
 
   // CLASS Adapter 
@@ -152,6 +246,7 @@ namespace cflApprox
 	std::transform(begin(m_uArg), end(m_uArg)-2, &m_uArg[1], 
 		       [dH](double dX){return dH+dX;});
 	m_uArg[m_uArg.size()-1] = m_dR;
+	m_pArg = std::make_shared<const std::vector<double> >(begin(m_uArg), end(m_uArg));
       }
       else {
 	ASSERT(m_uArg.size() == 1);
@@ -176,7 +271,37 @@ namespace cflApprox
 	return cfl::Function(rValues[0], m_dL, m_dR);
       }
       else { 
-	return m_uInterp.interpolate(cfl::begin(m_uArg), cfl::end(m_uArg), cfl::begin(rValues));
+	return m_uInterp.interpolate(m_pArg, cfl::begin(rValues));
+      }
+    }
+
+    void approximate(const double * pValues, unsigned iColumns, 
+		     const double * pArg, unsigned iPoints, double * pResult) const
+    {
+      unsigned iN = m_uArg.size();
+      if (iN == 1) {
+	for (unsigned iM=0; iM<iPoints; iM++) {
+	  std::copy(pValues, pValues + iColumns, pResult + iM*iColumns);
+	}
+	return;
+      }
+      if ((iColumns == 1) && (iPoints == 1)) {
+	//one point is evaluated directly from the values
+	pResult[0] = m_uInterp.value(m_pArg, pValues, pArg[0]);
+	return;
+      }
+      std::vector<Function> uApprox = 
+	m_uInterp.interpolate(m_pArg, std::vector<double>(pValues, pValues + iN*iColumns), 
+			      iColumns);
+      std::vector<double> uX(iPoints), uY(iPoints);
+      for (unsigned iJ=0; iJ<iColumns; iJ++) {
+	for (unsigned iM=0; iM<iPoints; iM++) {
+	  uX[iM] = pArg[iM*iColumns + iJ];
+	}
+	uApprox[iJ].evaluate(uX.data(), uY.data(), iPoints);
+	for (unsigned iM=0; iM<iPoints; iM++) {
+	  pResult[iM*iColumns + iJ] = uY[iM];
+	}
       }
     }
 
@@ -185,10 +310,27 @@ namespace cflApprox
     Interp m_uInterp;
     double m_dL, m_dR;
     std::valarray<double> m_uArg;
+    //the grid shared by all approximations
+    std::shared_ptr<const std::vector<double> > m_pArg;
   };
 }
 
 
+cfl::Function 
+cfl::seed(const Approx & rApprox, const std::valarray<double> & rValues, 
+	  unsigned iFirst)
+{
+  PRECONDITION(rValues.size() == rApprox.arg().size());
+  std::vector<Function> uBasis(rValues.size());
+  std::valarray<double> uUnit(0., rValues.size());
+  for (unsigned iI=0; iI<uBasis.size(); iI++) {
+    uUnit[iI] = 1.;
+    uBasis[iI] = rApprox.approximate(uUnit);
+    uUnit[iI] = 0.;
+  }
+  return seed(rApprox.approximate(rValues), uBasis, iFirst);
+}
+
 cfl::Approx cfl::NApprox::chebyshev(const Function & rSize) 
 {
   return Approx(new cflApprox::Chebyshev(rSize));
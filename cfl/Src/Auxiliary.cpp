@@ -24,21 +24,50 @@ namespace cflTridiag
   }
 
   void solve(const std::valarray<double> & rL, const std::valarray<double> & rD, 
-	     const std::valarray<double> & rU, std::valarray<double> & rX) 
+	     const std::valarray<double> & rU, double * pX) 
   {
     PRECONDITION(rL.size() == rU.size());
     PRECONDITION(rD.size() == rL.size()+1);
-    PRECONDITION(rX.size() == rD.size());
 
     int iSize = rD.size();
     //forward substitution
     for (int iI=0; iI<iSize-1; iI++) {
-      rX[iI+1] -= rL[iI]*rX[iI];
+      pX[iI+1] -= rL[iI]*pX[iI];
     }
     //backward substitution
-    rX[iSize-1] /= rD[iSize-1];
+    pX[iSize-1] /= rD[iSize-1];
     for (int iI=iSize-2; iI>=0; iI--) {
-      rX[iI] = (rX[iI] - rU[iI]*rX[iI+1])/rD[iI];
+      pX[iI] = (pX[iI] - rU[iI]*pX[iI+1])/rD[iI];
+    }		
+  }		
+
+  void solve(const std::valarray<double> & rL, const std::valarray<double> & rD, 
+	     const std::valarray<double> & rU, std::valarray<double> & rX, 
+	     unsigned iColumns) 
+  {
+    PRECONDITION(rL.size() == rU.size());
+    PRECONDITION(rD.size() == rL.size()+1);
+    PRECONDITION(rX.size() == rD.size()*iColumns);
+
+    int iSize = rD.size();
+    double * pX = &rX[0];
+    //forward substitution
+    for (int iI=0; iI<iSize-1; iI++) {
+      double * pY = pX + iI*iColumns;
+      for (unsigned iJ=0; iJ<iColumns; iJ++) {
+	pY[iColumns + iJ] -= rL[iI]*pY[iJ];
+      }
+    }
+    //backward substitution
+    double * pY = pX + (iSize-1)*iColumns;
+    for (unsigned iJ=0; iJ<iColumns; iJ++) {
+      pY[iJ] /= rD[iSize-1];
+    }
+    for (int iI=iSize-2; iI>=0; iI--) {
+      pY = pX + iI*iColumns;
+      for (unsigned iJ=0; iJ<iColumns; iJ++) {
+	pY[iJ] = (pY[iJ] - rU[iI]*pY[iColumns + iJ])/rD[iI];
+      }
     }		
   }		
 }
@@ -56,7 +85,18 @@ Tridiag(const std::valarray<double> & rL, const std::valarray<double> & rD,
 
 void cfl::Tridiag::solve(std::valarray<double> & rX) const 
 {
-  cflTridiag::solve(m_uL, m_uD, m_uU, rX);
+  PRECONDITION(rX.size() == m_uD.size());
+  cflTridiag::solve(m_uL, m_uD, m_uU, &rX[0]);
+}
+
+void cfl::Tridiag::solve(double * pX) const 
+{
+  cflTridiag::solve(m_uL, m_uD, m_uU, pX);
+}
+
+void cfl::Tridiag::solve(std::valarray<double> & rX, unsigned iColumns) const 
+{
+  cflTridiag::solve(m_uL, m_uD, m_uU, rX, iColumns);
 }
 
 void cfl::Tridiag::
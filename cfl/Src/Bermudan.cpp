@@ -0,0 +1,165 @@
+// Implementation of classes and functions declared in the corresponding *.hpp file.
+
+#include <algorithm>
+#include "cfl/Bermudan.hpp"
+#include "cfl/Error.hpp"
+
+using namespace cfl;
+
+namespace cflBermudan
+{
+  //the index of the first payment of rBond after dTime; the payments
+  //within c_dEps from dTime are regarded as paid
+  unsigned next(const Data::Schedule & rBond, double dTime)
+  {
+    return rBond.next(dTime + c_dEps);
+  }
+
+  //values at the initial time of the Bermudan options on coupon bonds
+  std::vector<Slice> option(const std::vector<Data::Schedule> & rBonds,
+			    const std::vector<double> & rStrikes,
+			    const std::vector<bool> & rCall,
+			    const std::vector<double> & rExerciseTimes,
+			    InterestRateModel & rModel)
+  {
+    PRECONDITION(rBonds.size() == rStrikes.size());
+    PRECONDITION(rBonds.size() == rCall.size());
+    PRECONDITION(rExerciseTimes.size() > 0);
+    PRECONDITION(rModel.initialTime() < rExerciseTimes.front());
+
+    std::vector<double> uEventTimes(rExerciseTimes);
+    uEventTimes.insert(uEventTimes.begin(), rModel.initialTime());
+    rModel.assignEventTimes(uEventTimes);
+
+    int iTime = uEventTimes.size()-1;
+    std::vector<Slice> uOption(rBonds.size(), rModel.cash(iTime, 0.));
+    std::vector<double> uMaturities;
+    std::vector<Slice> uDiscount;
+    while (iTime > 0) {
+      //uOption[k] is the value to continue for the trade k
+      double dTime = rModel.eventTimes()[iTime];
+
+      //the discount factors for the remaining payment times of all
+      //bonds are computed once and shared by the trades
+      uMaturities.clear();
+      for (unsigned iK=0; iK<rBonds.size(); iK++) {
+	const std::vector<double> & rTimes = rBonds[iK].paymentTimes();
+	uMaturities.insert(uMaturities.end(),
+			   rTimes.begin() + next(rBonds[iK], dTime), rTimes.end());
+      }
+      std::sort(uMaturities.begin(), uMaturities.end());
+      uMaturities.erase(std::unique(uMaturities.begin(), uMaturities.end()),
+			uMaturities.end());
+      uDiscount.clear();
+      for (unsigned iI=0; iI<uMaturities.size(); iI++) {
+	uDiscount.push_back(rModel.discount(iTime, uMaturities[iI]));
+      }
+
+      for (unsigned iK=0; iK<rBonds.size(); iK++) {
+	double dSign = rCall[iK] ? 1. : -1.;
+	const Data::Schedule & rBond = rBonds[iK];
+	unsigned iFirst = next(rBond, dTime);
+	if (iFirst == rBond.paymentTimes().size()) {
+	  uOption[iK] = max(uOption[iK], -dSign*rStrikes[iK]);
+	  continue;
+	}
+	std::vector<double>::const_iterator itT =
+	  std::lower_bound(uMaturities.cbegin(), uMaturities.cend(),
+			   rBond.paymentTimes()[iFirst]);
+	Slice uPayoff(uDiscount[itT - uMaturities.begin()]);
+	std::valarray<double> uBond(0., uPayoff.values().size());
+	for (unsigned iI=iFirst; iI<rBond.paymentTimes().size(); iI++) {
+	  itT = std::lower_bound(itT, uMaturities.cend(), rBond.paymentTimes()[iI]);
+	  ASSERT(*itT == rBond.paymentTimes()[iI]);
+	  const std::valarray<double> & rDiscount =
+	    uDiscount[itT - uMaturities.begin()].values();
+	  ASSERT(rDiscount.size() == uBond.size());
+	  uBond += rBond.payments()[iI]*rDiscount;
+	}
+	uBond -= rStrikes[iK];
+	uBond *= dSign;
+	uPayoff.assign(uBond);
+	uOption[iK] = max(uOption[iK], uPayoff);
+      }
+      iTime--;
+      rollback(uOption, iTime);
+    }
+    return uOption;
+  }
+
+  std::vector<MultiFunction> interpolate(const std::vector<Slice> & rValues)
+  {
+    std::vector<MultiFunction> uPrices;
+    uPrices.reserve(rValues.size());
+    for (unsigned iI=0; iI<rValues.size(); iI++) {
+      uPrices.push_back(cfl::interpolate(rValues[iI]));
+    }
+    return uPrices;
+  }
+}
+
+std::vector<MultiFunction>
+cfl::Bermudan::option(const std::vector<Data::Schedule> & rBonds,
+		      const std::vector<double> & rStrikes,
+		      const std::vector<bool> & rCall,
+		      const std::vector<double> & rExerciseTimes,
+		      InterestRateModel & rModel)
+{
+  return cflBermudan::interpolate(cflBermudan::option(rBonds, rStrikes, rCall,
+						      rExerciseTimes, rModel));
+}
+
+std::vector<MultiFunction>
+cfl::Bermudan::swaption(const std::vector<Data::Swap> & rSwaps,
+			const std::vector<double> & rExerciseTimes,
+			InterestRateModel & rModel)
+{
+  PRECONDITION(rExerciseTimes.size() > 0);
+  //if we receive fixed and pay float, then the swap is the call on
+  //the fixed leg with the strike equal the notional
+  std::vector<Data::Schedule> uBonds;
+  std::vector<double> uStrikes;
+  std::vector<bool> uCall;
+  uBonds.reserve(rSwaps.size());
+  for (unsigned iK=0; iK<rSwaps.size(); iK++) {
+    uBonds.push_back(Data::Schedule(rSwaps[iK], rExerciseTimes.front()));
+    uStrikes.push_back(rSwaps[iK].notional);
+    uCall.push_back(rSwaps[iK].payFloat);
+  }
+  return option(uBonds, uStrikes, uCall, rExerciseTimes, rModel);
+}
+
+MultiFunction cfl::Bermudan::swaption(const Data::Swap & rSwap,
+				      const std::vector<double> & rExerciseTimes,
+				      InterestRateModel & rModel)
+{
+  return swaption(std::vector<Data::Swap>(1, rSwap), rExerciseTimes, rModel).front();
+}
+
+std::vector<MultiFunction>
+cfl::Bermudan::callableBond(const std::vector<Data::CashFlow> & rBonds,
+			    const std::vector<double> & rCallTimes,
+			    InterestRateModel & rModel)
+{
+  std::vector<Data::Schedule> uBonds;
+  std::vector<double> uStrikes;
+  uBonds.reserve(rBonds.size());
+  for (unsigned iK=0; iK<rBonds.size(); iK++) {
+    uBonds.push_back(Data::Schedule(rBonds[iK], rModel.initialTime()));
+    uStrikes.push_back(rBonds[iK].notional);
+  }
+  std::vector<Slice> uCallable =
+    cflBermudan::option(uBonds, uStrikes, std::vector<bool>(rBonds.size(), true),
+			rCallTimes, rModel);
+  for (unsigned iK=0; iK<rBonds.size(); iK++) {
+    uCallable[iK] = rModel.value(0, uBonds[iK]) - uCallable[iK];
+  }
+  return cflBermudan::interpolate(uCallable);
+}
+
+MultiFunction cfl::Bermudan::callableBond(const Data::CashFlow & rBond,
+					  const std::vector<double> & rCallTimes,
+					  InterestRateModel & rModel)
+{
+  return callableBond(std::vector<Data::CashFlow>(1, rBond), rCallTimes, rModel).front();
+}
@@ -0,0 +1,157 @@
+// Implementation of classes and functions declared in the corresponding *.hpp file.
+
+#include <cmath>
+#include <limits>
+#include "cfl/BlackAnalytic.hpp"
+#include "cfl/Error.hpp"
+
+using namespace cfl;
+using namespace cfl::Black;
+
+namespace cflBlack
+{
+  const double c_dSqrt1_2 = 0.70710678118654752440;
+  //the constant -zeta(1/2)/sqrt(2*pi) in the continuity correction
+  const double c_dBeta = 0.58259715793901;
+
+  //closed-form price of one option as function of the state process
+  class Formula: public IFunction
+  {
+  public:
+    Formula(const Black::Data & rData, const European & rOption)
+      :m_uData(rData), m_uOption(1, rOption)
+    {}
+
+    double operator()(double dX) const
+    {
+      double dPrice;
+      Black::price(m_uData, m_uOption, &dX, &dPrice, 1);
+      return dPrice;
+    }
+
+    void evaluate(const double * pX, double * pY, size_t iSize) const
+    {
+      Black::price(m_uData, m_uOption, pX, pY, iSize);
+    }
+
+    bool belongs(double) const
+    {
+      return true;
+    }
+
+  private:
+    Black::Data m_uData;
+    std::vector<European> m_uOption;
+  };
+}
+
+void cfl::Black::price(const Data & rData, const std::vector<European> & rOptions,
+		       const double * pX, double * pPrice, size_t iSize)
+{
+  //the curves are evaluated once for all maturities
+  unsigned iOptions = rOptions.size();
+  double dInitialTime = rData.initialTime();
+  std::vector<double> uT(iOptions), uDiscount(iOptions), uForward(iOptions),
+    uShape(iOptions), uVol(iOptions);
+  for (unsigned iI=0; iI<iOptions; iI++) {
+    PRECONDITION(rOptions[iI].maturity >= dInitialTime);
+    uT[iI] = rOptions[iI].maturity;
+  }
+  rData.discount().evaluate(uT.data(), uDiscount.data(), iOptions);
+  rData.forward().evaluate(uT.data(), uForward.data(), iOptions);
+  rData.shape().evaluate(uT.data(), uShape.data(), iOptions);
+  rData.volatility().evaluate(uT.data(), uVol.data(), iOptions);
+
+  //uF is the forward price for the state pX[iJ]; uN1 and uN2 are the
+  //normal distribution functions at +-d1 and +-d2
+  std::vector<double> uF(iSize), uN1(iSize), uN2(iSize);
+  const double c_dInf = std::numeric_limits<double>::infinity();
+  for (unsigned iI=0; iI<iOptions; iI++) {
+    const European & rOption = rOptions[iI];
+    double dK = rOption.strike;
+    double dShape = uShape[iI];
+    double dStd = std::abs(dShape)*uVol[iI]*std::sqrt(uT[iI] - dInitialTime);
+    double dLogF = std::log(uForward[iI]/dK);
+    //the payoffs with the sign -1 depend on the distribution
+    //functions at -d1 and -d2
+    bool bPut = (rOption.payoff == European::ePut) ||
+      (rOption.payoff == European::eDigitalPut);
+    double dSign = (bPut) ? -1. : 1.;
+    if (dStd > 0.) {
+      double dInvStd = 1./dStd;
+      for (size_t iJ=0; iJ<iSize; iJ++) {
+	double dD1 = (dLogF + dShape*pX[iJ])*dInvStd + 0.5*dStd;
+	uN1[iJ] = dSign*dD1;
+	uN2[iJ] = dSign*(dD1 - dStd);
+      }
+    }
+    else {
+      for (size_t iJ=0; iJ<iSize; iJ++) {
+	double dM = dLogF + dShape*pX[iJ];
+	uN1[iJ] = (dM > 0.) ? dSign*c_dInf : -dSign*c_dInf;
+	uN2[iJ] = uN1[iJ];
+      }
+    }
+    for (size_t iJ=0; iJ<iSize; iJ++) {
+      uF[iJ] = uForward[iI]*std::exp(dShape*pX[iJ]);
+      uN1[iJ] = 0.5*std::erfc(-uN1[iJ]*cflBlack::c_dSqrt1_2);
+      uN2[iJ] = 0.5*std::erfc(-uN2[iJ]*cflBlack::c_dSqrt1_2);
+    }
+    double dD = uDiscount[iI];
+    double * pP = pPrice + iI*iSize;
+    switch (rOption.payoff) {
+    case European::eCall:
+      for (size_t iJ=0; iJ<iSize; iJ++) {
+	pP[iJ] = dD*(uF[iJ]*uN1[iJ] - dK*uN2[iJ]);
+      }
+      break;
+    case European::ePut:
+      for (size_t iJ=0; iJ<iSize; iJ++) {
+	pP[iJ] = dD*(dK*uN2[iJ] - uF[iJ]*uN1[iJ]);
+      }
+      break;
+    case European::eStraddle:
+      //straddle = 2*call - (forward - strike)
+      for (size_t iJ=0; iJ<iSize; iJ++) {
+	pP[iJ] = dD*(2.*(uF[iJ]*uN1[iJ] - dK*uN2[iJ]) - (uF[iJ] - dK));
+      }
+      break;
+    default:
+      ASSERT((rOption.payoff == European::eDigitalCall) ||
+	     (rOption.payoff == European::eDigitalPut));
+      for (size_t iJ=0; iJ<iSize; iJ++) {
+	pP[iJ] = dD*uN2[iJ];
+      }
+    }
+  }
+}
+
+MultiFunction cfl::Black::price(const Data & rData, const European & rOption)
+{
+  return toMultiFunction(Function(new cflBlack::Formula(rData, rOption)), 0, 1);
+}
+
+Slice cfl::Black::payoff(const European & rOption, const Slice & rSpot)
+{
+  switch (rOption.payoff) {
+  case European::eCall:
+    return max(rSpot - rOption.strike, 0.);
+  case European::ePut:
+    return max(rOption.strike - rSpot, 0.);
+  case European::eStraddle:
+    return abs(rSpot - rOption.strike);
+  case European::eDigitalCall:
+    return indicator(rSpot, rOption.strike);
+  default:
+    ASSERT(rOption.payoff == European::eDigitalPut);
+    return indicator(rOption.strike, rSpot);
+  }
+}
+
+double cfl::Black::continuousBarrier(double dBarrier, bool bLower, 
+				     double dVolatility, double dPeriod)
+{
+  PRECONDITION((dVolatility >= 0.) && (dPeriod >= 0.));
+  double dShift = std::exp(cflBlack::c_dBeta*dVolatility*std::sqrt(dPeriod));
+  return bLower ? dBarrier/dShift : dBarrier*dShift;
+}
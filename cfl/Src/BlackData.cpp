@@ -12,9 +12,9 @@ cfl::Black::Data::Data(const Function & rDiscount,
 		       const Function & rForward, 
 		       const Function  & rVolatility,	
 		       double dInitialTime)
-  :m_uDiscount(rDiscount), 
-   m_uForward(rForward), 
-   m_uVolatility(rVolatility), 
+  :m_uDiscount(compile(rDiscount)), 
+   m_uForward(compile(rForward)), 
+   m_uVolatility(compile(rVolatility)), 
    m_uShape(1.), 
    m_dInitialTime(dInitialTime)
 {}
@@ -23,8 +23,8 @@ cfl::Black::Data::Data(const Function & rDiscount,
 		       const Function & rForward, 
 		       double dSigma, 
 		       double dInitialTime)
-  :m_uDiscount(rDiscount), 
-   m_uForward(rForward), 
+  :m_uDiscount(compile(rDiscount)), 
+   m_uForward(compile(rForward)), 
    m_uVolatility(dSigma), 
    m_uShape(1.), 
    m_dInitialTime(dInitialTime)
@@ -35,10 +35,10 @@ cfl::Black::Data::Data(const Function & rDiscount,
 		       const Function  & rVolatility,	
 		       const Function  & rShape, 
 		       double dInitialTime)
-  :m_uDiscount(rDiscount), 
-   m_uForward(rForward), 
-   m_uVolatility(rVolatility), 
-   m_uShape(rShape), 
+  :m_uDiscount(compile(rDiscount)), 
+   m_uForward(compile(rForward)), 
+   m_uVolatility(compile(rVolatility)), 
+   m_uShape(compile(rShape)), 
    m_dInitialTime(dInitialTime) 
 {}
 
@@ -47,7 +47,7 @@ cfl::Black::Data::Data(const Function & rDiscount,
 		       double dSigma, 
 		       double dLambda, 
 		       double dInitialTime)
-  :m_uDiscount(rDiscount), m_uForward(rForward), 
+  :m_uDiscount(compile(rDiscount)), m_uForward(compile(rForward)), 
    m_uVolatility(cfl::Data::volatility(dSigma, dLambda, dInitialTime)), 
    m_uShape(cfl::Data::assetShape(dLambda, dInitialTime)), 
    m_dInitialTime(dInitialTime)
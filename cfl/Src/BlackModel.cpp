@@ -1,6 +1,8 @@
 //Copyright (c) Dmitry Kramkov, 2000-2006. All rights reserved. 
 
 #include <limits>
+#include <map>
+#include <mutex>
 #include "cfl/BlackModel.hpp"
 #include "cfl/Error.hpp"
 
@@ -35,16 +37,41 @@ namespace cflBlack
 		       const std::vector<unsigned> & rStates) const;
 
     void rollback(Slice & rSlice, unsigned iEventTime) const;
+    void rollback(std::vector<Slice> & rSlices, unsigned iEventTime) const;
+    void rollback(Slice & rSlice, unsigned iEventTime, 
+		  const Slice & rStart, const Slice & rEnd, 
+		  double dLowerBarrier, double dUpperBarrier) const;
 
     void indicator(Slice & rSlice, double dBarrier) const;
+    std::vector<Slice> indicator(const Slice & rSlice, 
+				 const std::vector<double> & rBarriers) const;
 
     MultiFunction interpolate(const Slice & rSlice) const;
 
   private:
+    //(index of event time, maturity of forward)
+    typedef std::pair<unsigned, double> Key;
+    typedef std::map<Key, Slice> Cache;
+
+    Slice newForward(unsigned iTime, double dForwardMaturity) const;
+    void remember(const Key & rKey, const Slice & rSlice) const;
+
     Black::Data m_uData; 
     double m_dInterval;
     Brownian m_uBrownian; 
+    //discount factors for the event times
+    std::vector<double> m_uDiscount;
+    //forward slices computed before; the model is rebuilt when event
+    //times change, hence the cache is never invalidated
+    mutable Cache m_uCache;
+    //the total number of values in the cache
+    mutable size_t m_iCached;
+    //guards the cache, as the model can be shared by several threads
+    mutable std::mutex m_uMutex;
   };
+
+  //the maximal number of values in the cache of forward slices
+  const size_t c_iMaxCached = 1 << 20;
 }
 
 // FUNCTION: cfl::Black::model
@@ -62,12 +89,15 @@ AssetModel cfl::Black::model(const Data & rData,
 
 cflBlack::Model::Model(const Black::Data & rData, const std::vector<double> & rEventTimes, 
 		       double dInterval, const Brownian & rBrownian)
-  :m_uData(rData), m_dInterval(dInterval), m_uBrownian(rBrownian)
+  :m_uData(rData), m_dInterval(dInterval), m_uBrownian(rBrownian), 
+   m_uDiscount(rEventTimes.size()), m_iCached(0)
 {
   ASSERT(rEventTimes.front() == rData.initialTime());
+  rData.discount().evaluate(rEventTimes.data(), m_uDiscount.data(), 
+			    m_uDiscount.size());
   std::vector<double> uVar(rEventTimes.size());
-  std::transform(rEventTimes.begin(), rEventTimes.end(), uVar.begin(), 
-		 cfl::pow(rData.volatility(), 2));
+  cfl::pow(rData.volatility(), 2).evaluate(rEventTimes.data(), uVar.data(), 
+					  uVar.size());
   m_uBrownian.assign(uVar, rEventTimes, dInterval);
 }
 
@@ -78,11 +108,30 @@ IAssetModel * cflBlack::Model::newModel(const std::vector<double> & rEventTimes)
 
 Slice cflBlack::Model::discount(unsigned iTime, double dMaturity) const 
 {
-  double dTime = eventTimes()[iTime];
-  double dFactor = m_uData.discount()(dMaturity)/m_uData.discount()(dTime); 
+  double dFactor = m_uData.discount()(dMaturity)/m_uDiscount[iTime]; 
   return Slice(this, iTime, dFactor);
 } 
 
+void cflBlack::Model::remember(const Key & rKey, const Slice & rSlice) const 
+{
+  if (rSlice.values().size() > c_iMaxCached) {
+    return;
+  }
+  std::lock_guard<std::mutex> uLock(m_uMutex);
+  if (!m_uCache.insert(std::make_pair(rKey, rSlice)).second) {
+    //the slice has been added by another thread
+    return;
+  }
+  m_iCached += rSlice.values().size();
+  //backward induction moves to smaller event times, hence we remove 
+  //the slices with the largest indexes of event times
+  while (m_iCached > c_iMaxCached) {
+    Cache::iterator itLast = --m_uCache.end();
+    m_iCached -= itLast->second.values().size();
+    m_uCache.erase(itLast);
+  }
+}
+
 const std::vector<double> & cflBlack::Model::eventTimes() const
 {
   return m_uBrownian.eventTimes();
@@ -120,15 +169,42 @@ void cflBlack::Model::addDependence(Slice & rSlice,
 
 void cflBlack::Model::rollback(Slice & rSlice, unsigned iEventTime) const 
 {
-  double dToday = eventTimes()[iEventTime];
-  double dMaturity = eventTimes()[rSlice.timeIndex()];
-  double dDiscount = m_uData.discount()(dMaturity)/m_uData.discount()(dToday);
+  double dDiscount = m_uDiscount[rSlice.timeIndex()]/m_uDiscount[iEventTime];
   rSlice.assign(m_uBrownian);
   rSlice.rollback(iEventTime);
   rSlice.assign(*this);
   rSlice *= dDiscount; 
 }
 
+void cflBlack::Model::rollback(std::vector<Slice> & rSlices, unsigned iEventTime) const 
+{
+  std::vector<double> uDiscount(rSlices.size());
+  for (unsigned iI=0; iI<rSlices.size(); iI++) {
+    uDiscount[iI] = m_uDiscount[rSlices[iI].timeIndex()]/m_uDiscount[iEventTime];
+    rSlices[iI].assign(m_uBrownian);
+  }
+  m_uBrownian.rollback(rSlices, iEventTime);
+  for (unsigned iI=0; iI<rSlices.size(); iI++) {
+    rSlices[iI].assign(*this);
+    rSlices[iI] *= uDiscount[iI];
+  }
+}
+
+void cflBlack::Model::rollback(Slice & rSlice, unsigned iEventTime, 
+			       const Slice & rStart, const Slice & rEnd, 
+			       double dLowerBarrier, double dUpperBarrier) const 
+{
+  double dDiscount = m_uDiscount[rSlice.timeIndex()]/m_uDiscount[iEventTime];
+  Slice uStart(rStart);
+  uStart.assign(m_uBrownian);
+  Slice uEnd(rEnd);
+  uEnd.assign(m_uBrownian);
+  rSlice.assign(m_uBrownian);
+  m_uBrownian.rollback(rSlice, iEventTime, uStart, uEnd, dLowerBarrier, dUpperBarrier);
+  rSlice.assign(*this);
+  rSlice *= dDiscount; 
+}
+
 void cflBlack::Model::indicator(Slice & rSlice, double dBarrier) const
 {
   rSlice.assign(m_uBrownian);
@@ -136,6 +212,18 @@ void cflBlack::Model::indicator(Slice & rSlice, double dBarrier) const
   rSlice.assign(*this);
 }
 
+std::vector<Slice> 
+cflBlack::Model::indicator(const Slice & rSlice, const std::vector<double> & rBarriers) const
+{
+  Slice uSlice(rSlice);
+  uSlice.assign(m_uBrownian);
+  std::vector<Slice> uInd = m_uBrownian.indicator(uSlice, rBarriers);
+  for (unsigned iK=0; iK<uInd.size(); iK++) {
+    uInd[iK].assign(*this);
+  }
+  return uInd;
+}
+
 MultiFunction cflBlack::Model::interpolate(const Slice & rSlice) const
 {
   Slice uSlice(rSlice);
@@ -145,6 +233,22 @@ MultiFunction cflBlack::Model::interpolate(const Slice & rSlice) const
 
 Slice cflBlack::Model::
 forward(unsigned iTime, double dForwardMaturity) const
+{
+  Key uKey(iTime, dForwardMaturity);
+  {
+    std::lock_guard<std::mutex> uLock(m_uMutex);
+    Cache::const_iterator itSlice = m_uCache.find(uKey);
+    if (itSlice != m_uCache.end()) {
+      return itSlice->second;
+    }
+  }
+  Slice uForward = newForward(iTime, dForwardMaturity);
+  remember(uKey, uForward);
+  return uForward;
+}
+
+Slice cflBlack::Model::
+newForward(unsigned iTime, double dForwardMaturity) const
 {
   PRECONDITION(iTime < eventTimes().size());
   double dRefTime = eventTimes()[iTime];
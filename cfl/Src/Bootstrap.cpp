@@ -0,0 +1,200 @@
+// Implementation of classes and functions declared in the corresponding *.hpp file.
+
+#include <cmath>
+#include <algorithm>
+#include <utility>
+#include "cfl/Bootstrap.hpp"
+#include "cfl/Error.hpp"
+
+using namespace cfl;
+
+// CLASS: Bootstrap
+
+cfl::Bootstrap::Bootstrap(double dInitialTime)
+  :m_dInitialTime(dInitialTime), m_iSolved(0), m_iVersion(0)
+{
+  m_uKnots.time.assign(1, dInitialTime);
+  m_uKnots.logDiscount.assign(1, 0.);
+}
+
+unsigned cfl::Bootstrap::deposit(double dMaturity, double dRate)
+{
+  Instrument uI = { eDeposit, m_dInitialTime, dMaturity, dMaturity - m_dInitialTime,
+		    dRate, 0., 1 };
+  return add(uI);
+}
+
+unsigned cfl::Bootstrap::fra(double dStart, double dPeriod, double dRate)
+{
+  PRECONDITION(dStart >= m_dInitialTime);
+  Instrument uI = { eFra, dStart, dStart + dPeriod, dPeriod, dRate, 0., 1 };
+  return add(uI);
+}
+
+unsigned cfl::Bootstrap::future(double dStart, double dPeriod, double dPrice,
+				double dConvexity)
+{
+  PRECONDITION(dStart >= m_dInitialTime);
+  Instrument uI = { eFuture, dStart, dStart + dPeriod, dPeriod, dPrice,
+		    dConvexity, 1 };
+  return add(uI);
+}
+
+unsigned cfl::Bootstrap::swap(const Data::Swap & rSwap)
+{
+  PRECONDITION(rSwap.numberOfPayments > 0);
+  Instrument uI = { eSwap, m_dInitialTime + rSwap.period,
+		    m_dInitialTime + rSwap.period*rSwap.numberOfPayments,
+		    rSwap.period, rSwap.rate, 0., rSwap.numberOfPayments };
+  return add(uI);
+}
+
+void cfl::Bootstrap::update(unsigned iQuote, double dQuote)
+{
+  update(std::vector<unsigned>(1, iQuote), std::vector<double>(1, dQuote));
+}
+
+void cfl::Bootstrap::update(const std::vector<unsigned> & rQuotes,
+			    const std::vector<double> & rValues)
+{
+  PRECONDITION(rQuotes.size() == rValues.size());
+  Knots uKnots(m_uKnots);
+  std::vector<unsigned> uForced;
+  for (unsigned iI=0; iI<rQuotes.size(); iI++) {
+    PRECONDITION(rQuotes[iI] < uKnots.instruments.size());
+    uKnots.instruments[rQuotes[iI]].dQuote = rValues[iI];
+    unsigned iKnot = std::find(uKnots.order.begin(), uKnots.order.end(), rQuotes[iI])
+      - uKnots.order.begin();
+    uForced.push_back(iKnot + 1);
+  }
+  unsigned iSolved = rebuild(uKnots, uForced);
+  publish(uKnots, iSolved);
+}
+
+unsigned cfl::Bootstrap::add(const Instrument & rInstrument)
+{
+  PRECONDITION(rInstrument.dMaturity > m_dInitialTime);
+  Knots uKnots(m_uKnots);
+  std::vector<double>::iterator itT =
+    std::lower_bound(uKnots.time.begin(), uKnots.time.end(), rInstrument.dMaturity);
+  if ((itT != uKnots.time.end()) && (*itT == rInstrument.dMaturity)) {
+    throw(NError::range("maturity of the instrument in bootstrapping"));
+  }
+  unsigned iKnot = itT - uKnots.time.begin();
+  //the first guess is the flat extrapolation of the previous knot
+  double dLogDiscount = (iKnot == 1) ? 0. : uKnots.logDiscount[iKnot-1]*
+    (rInstrument.dMaturity - m_dInitialTime)/(uKnots.time[iKnot-1] - m_dInitialTime);
+  uKnots.time.insert(itT, rInstrument.dMaturity);
+  uKnots.logDiscount.insert(uKnots.logDiscount.begin() + iKnot, dLogDiscount);
+  uKnots.order.insert(uKnots.order.begin() + iKnot - 1, uKnots.instruments.size());
+  uKnots.instruments.push_back(rInstrument);
+  unsigned iSolved = rebuild(uKnots, std::vector<unsigned>(1, iKnot), true);
+  publish(uKnots, iSolved);
+  return m_uKnots.instruments.size() - 1;
+}
+
+double cfl::Bootstrap::logDiscount(const Knots & rKnots, double dT) const
+{
+  const std::vector<double> & rTime = rKnots.time;
+  const std::vector<double> & rLogDiscount = rKnots.logDiscount;
+  ASSERT((dT >= rTime.front()) && (dT <= rTime.back()));
+  unsigned iI = std::upper_bound(rTime.begin(), rTime.end(), dT) - rTime.begin();
+  if (iI == rTime.size()) {
+    return rLogDiscount.back();
+  }
+  ASSERT(iI > 0);
+  double dW = (dT - rTime[iI-1])/(rTime[iI] - rTime[iI-1]);
+  return (1. - dW)*rLogDiscount[iI-1] + dW*rLogDiscount[iI];
+}
+
+double cfl::Bootstrap::residual(const Knots & rKnots, const Instrument & rI) const
+{
+  switch (rI.eType) {
+  case eDeposit:
+    return logDiscount(rKnots, rI.dMaturity) + std::log(1. + rI.dQuote*rI.dPeriod);
+  case eFra:
+    return logDiscount(rKnots, rI.dMaturity) - logDiscount(rKnots, rI.dStart)
+      + std::log(1. + rI.dQuote*rI.dPeriod);
+  case eFuture:
+    return logDiscount(rKnots, rI.dMaturity) - logDiscount(rKnots, rI.dStart)
+      + std::log(1. + (1. - rI.dQuote - rI.dConvexity)*rI.dPeriod);
+  default:
+    ASSERT(rI.eType == eSwap);
+    //the value of the fixed leg minus the value of the float leg
+    double dFixed = 0.;
+    for (unsigned iK=1; iK<=rI.iPayments; iK++) {
+      double dT = (iK == rI.iPayments) ? rI.dMaturity : m_dInitialTime + iK*rI.dPeriod;
+      dFixed += std::exp(logDiscount(rKnots, dT));
+    }
+    dFixed *= rI.dQuote*rI.dPeriod;
+    return dFixed + std::exp(logDiscount(rKnots, rI.dMaturity)) - 1.;
+  }
+}
+
+unsigned cfl::Bootstrap::rebuild(Knots & rKnots, const std::vector<unsigned> & rForced,
+				 bool bNewKnot) const
+{
+  const std::vector<double> & rTime = rKnots.time;
+  std::vector<double> & rLogDiscount = rKnots.logDiscount;
+  const unsigned c_iMaxIter = 100;
+  const double c_dStep = 1e-4;
+  std::vector<bool> uChanged(rTime.size(), false);
+  unsigned iFirst = *std::min_element(rForced.begin(), rForced.end());
+  std::vector<bool> uForced(rTime.size(), false);
+  for (unsigned iI=0; iI<rForced.size(); iI++) {
+    uForced[rForced[iI]] = true;
+  }
+  unsigned iSolved = 0;
+  for (unsigned iJ=iFirst; iJ<rTime.size(); iJ++) {
+    const Instrument & rI = rKnots.instruments[rKnots.order[iJ-1]];
+    //the knot depends on the knots with the indexes [iLow, iJ)
+    unsigned iLow = (rI.eType == eDeposit) ? iJ : 
+      std::upper_bound(rTime.begin(), rTime.begin() + iJ, rI.dStart)
+      - rTime.begin() - 1;
+    bool bSolve = uForced[iJ] ||
+      (std::find(uChanged.begin() + iLow, uChanged.begin() + iJ, true)
+       != uChanged.begin() + iJ);
+    if (!bSolve) {
+      continue;
+    }
+    iSolved++;
+    //secant method for the logarithm of the discount factor
+    double dOld = rLogDiscount[iJ];
+    double dX0 = dOld;
+    double dR0 = residual(rKnots, rI);
+    double dX1 = dX0 - c_dStep;
+    rLogDiscount[iJ] = dX1;
+    double dR1 = residual(rKnots, rI);
+    unsigned iIter = 0;
+    while ((dR1 != 0.) && (dR1 != dR0) && (dX1 != dX0) && (iIter < c_iMaxIter)) {
+      double dX2 = dX1 - dR1*(dX1 - dX0)/(dR1 - dR0);
+      dX0 = dX1;
+      dR0 = dR1;
+      dX1 = dX2;
+      rLogDiscount[iJ] = dX1;
+      dR1 = residual(rKnots, rI);
+      iIter++;
+    }
+    if (!(std::abs(dR1) < 1e-10)) {
+      throw(NError::range("bootstrapping of discount curve"));
+    }
+    uChanged[iJ] = (rLogDiscount[iJ] != dOld) || (bNewKnot && uForced[iJ]);
+  }
+  return iSolved;
+}
+
+void cfl::Bootstrap::publish(Knots & rKnots, unsigned iSolved)
+{
+  std::swap(m_uKnots, rKnots);
+  m_iSolved = iSolved;
+  std::shared_ptr<Curve> pCurve(new Curve());
+  pCurve->version = ++m_iVersion;
+  pCurve->times.assign(m_uKnots.time.begin() + 1, m_uKnots.time.end());
+  pCurve->discountFactors.resize(pCurve->times.size());
+  for (unsigned iI=0; iI<pCurve->times.size(); iI++) {
+    pCurve->discountFactors[iI] = std::exp(m_uKnots.logDiscount[iI+1]);
+  }
+  pCurve->discount = Data::discount(pCurve->times, pCurve->discountFactors,
+				    m_dInitialTime);
+  std::atomic_store(&m_pCurve, std::shared_ptr<const Curve>(pCurve));
+}
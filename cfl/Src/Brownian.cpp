@@ -4,6 +4,7 @@
 #include <cmath>
 #include <algorithm>
 #include <limits>
+#include <map>
 #include "cfl/Brownian.hpp"
 #include "cfl/GaussRollback.hpp"
 #include "cfl/Ind.hpp"
@@ -38,6 +39,40 @@ namespace cflBrownian
     double m_dToday;
   };
 
+  //finds the state rX where the values rU of the underlying on the
+  //grid with step dH centered at zero cross the barrier dBarrier;
+  //returns false if they do not cross it
+  bool crossing(const std::valarray<double> & rU, double dH, double dBarrier, 
+		double & rX)
+  {
+    double dCenter = 0.5*(rU.size()-1);
+    for (unsigned iI=0; iI+1<rU.size(); iI++) {
+      double dL = rU[iI] - dBarrier;
+      double dR = rU[iI+1] - dBarrier;
+      if ((dL <= 0.) != (dR <= 0.)) {
+	rX = (iI - dCenter + dL/(dL - dR))*dH;
+	return true;
+      }
+    }
+    return false;
+  }
+
+  //linear interpolation of the values rV on the grid with step dH
+  //centered at zero; the values outside of the grid equal zero
+  double value(const std::valarray<double> & rV, double dH, double dX)
+  {
+    double dI = dX/dH + 0.5*(rV.size()-1);
+    if ((dI < 0.) || (dI > rV.size()-1)) {
+      return 0.;
+    }
+    unsigned iI = static_cast<unsigned>(dI);
+    if (iI+1 == rV.size()) {
+      return rV[iI];
+    }
+    double dW = dI - iI;
+    return (1.-dW)*rV[iI] + dW*rV[iI+1];
+  }
+
   class Model: public cfl::IBrownian
   {
   public:
@@ -59,15 +94,28 @@ namespace cflBrownian
     void addDependence(Slice & rSlice, const std::vector<unsigned> & rDependence) const;
 
     void rollback(Slice & rSlice, unsigned iTime) const;
+    void rollback(std::vector<Slice> & rSlices, unsigned iTime) const;
+    void rollback(Slice & rSlice, unsigned iTime, 
+		  const Slice & rStart, const Slice & rEnd, 
+		  double dLowerBarrier, double dUpperBarrier) const;
 
     void indicator(Slice & rSlice, double dBarrier) const;
+    std::vector<Slice> indicator(const Slice & rSlice, 
+				 const std::vector<double> & rBarriers) const;
 
     MultiFunction interpolate(const Slice & rSlice) const;
 
   private:
+    //rolls back the slices with indexes rColumns; they have the same
+    //event time and the same number of nodes
+    void rollback(std::vector<Slice> & rSlices, 
+		  const std::vector<unsigned> & rColumns, unsigned iTime) const;
+
     std::vector<double> m_uTotalVar, m_uEventTimes;
     double m_dInterval, m_dNumberOfStd, m_dH, m_dQuality;
     std::vector<unsigned> m_uSize;
+    //grids of states shared by interpolated functions
+    std::vector<std::shared_ptr<const std::vector<double> > > m_uGrid;
     GaussRollback m_uGaussRollback;
     Ind m_uInd;
     Interp m_uInterp;
@@ -117,6 +165,14 @@ cflBrownian::Model::Model(const std::vector<double> & rVar, const std::vector<do
       ASSERT(m_uSize[iI]>0);
       ASSERT(m_uSize[iI]%2==1);
     }
+  m_uGrid.resize(m_uSize.size());
+  for (unsigned iI=0; iI<m_uSize.size(); iI++) {
+    std::vector<double> uArg(m_uSize[iI]);
+    uArg[0] = -m_dH*(m_uSize[iI]-1)/2;
+    std::transform(uArg.begin(), uArg.end()-1, uArg.begin()+1, 
+		   [this](double dX){return m_dH+dX;}); 
+    m_uGrid[iI] = std::make_shared<const std::vector<double> >(std::move(uArg));
+  }
   ASSERT(m_uSize[0]*m_dH >= dInterval);
   POSTCONDITION(m_uTotalVar.size() == m_uEventTimes.size());
   POSTCONDITION(m_uTotalVar.size() == m_uSize.size());
@@ -146,11 +202,8 @@ Slice cflBrownian::Model::state(unsigned iTime, unsigned iState) const
 
   std::vector<unsigned> uDependence(1,0);
 
-  int iSize = m_uSize[iTime];
-  std::valarray<double> uValues(iSize);
-  uValues[0] = -m_dH*(iSize-1)/2;
-  std::transform(&uValues[0], &uValues[iSize-1], &uValues[1], 
-		 [this](double dX){return m_dH+dX;}); 
+  const std::vector<double> & rGrid = *m_uGrid[iTime];
+  std::valarray<double> uValues(rGrid.data(), rGrid.size());
 
   return Slice(*this, iTime, uDependence, uValues);
 }
@@ -220,6 +273,143 @@ void cflBrownian::Model::rollback(Slice & rSlice, unsigned iTime) const
   }
 }
 
+void cflBrownian::Model::rollback(std::vector<Slice> & rSlices, unsigned iTime) const 
+{
+  //indexes of slices grouped by event time and number of nodes
+  std::map<std::pair<unsigned, unsigned>, std::vector<unsigned> > uGroups;
+  for (unsigned iI=0; iI<rSlices.size(); iI++) {
+    const Slice & rSlice = rSlices[iI];
+    PRECONDITION(rSlice.dependence().size() <=1);
+    PRECONDITION(rSlice.ptrToModel() == this);
+    PRECONDITION(rSlice.timeIndex() >= iTime);
+    if ((rSlice.timeIndex() == iTime) || (rSlice.values().size() == 1)) {
+      rollback(rSlices[iI], iTime);
+    }
+    else {
+      uGroups[std::make_pair(rSlice.timeIndex(), 
+			     static_cast<unsigned>(rSlice.values().size()))].push_back(iI);
+    }
+  }
+  std::map<std::pair<unsigned, unsigned>, std::vector<unsigned> >::const_iterator itG;
+  for (itG = uGroups.begin(); itG != uGroups.end(); itG++) {
+    if (itG->second.size() == 1) {
+      rollback(rSlices[itG->second.front()], iTime);
+    }
+    else {
+      rollback(rSlices, itG->second, iTime);
+    }
+  }
+}
+
+void cflBrownian::Model::rollback(std::vector<Slice> & rSlices, 
+				  const std::vector<unsigned> & rColumns, 
+				  unsigned iTime) const 
+{
+  unsigned iT = rSlices[rColumns.front()].timeIndex();
+  unsigned iSize = rSlices[rColumns.front()].values().size();
+  unsigned iColumns = rColumns.size();
+  ASSERT(iT > iTime);
+  //the slices are the columns of the matrix stored row by row
+  std::valarray<double> uValues(iSize*iColumns);
+  for (unsigned iJ=0; iJ<iColumns; iJ++) {
+    ASSERT(rSlices[rColumns[iJ]].values().size() == iSize);
+    uValues[std::slice(iJ, iSize, iColumns)] = rSlices[rColumns[iJ]].values();
+  }
+  double dVar = m_uTotalVar[iT] - m_uTotalVar[iTime];
+  ASSERT(dVar >= 0);
+  if (dVar == 0) {
+    dVar = c_dEps;
+  }
+  GaussRollback uRoll(m_uGaussRollback);
+  uRoll.assign(iSize, m_dH, dVar);
+  uRoll.rollback(uValues, iColumns);
+  unsigned iSize1 = m_uSize[iTime];
+  ASSERT(iSize1 <= iSize);
+  unsigned iShift = (iSize-iSize1)/2;
+  ASSERT(2*iShift + iSize1 == iSize);
+  for (unsigned iJ=0; iJ<iColumns; iJ++) {
+    Slice & rSlice = rSlices[rColumns[iJ]];
+    std::valarray<double> uT(uValues[std::slice(iShift*iColumns + iJ, iSize1, iColumns)]);
+    rSlice.assign(iTime, rSlice.dependence(), uT);
+  }
+}
+
+void cflBrownian::Model::rollback(Slice & rSlice, unsigned iTime, 
+				  const Slice & rStart, const Slice & rEnd, 
+				  double dLowerBarrier, double dUpperBarrier) const
+{
+  PRECONDITION(rSlice.ptrToModel() == this);
+  PRECONDITION(rStart.timeIndex() == iTime);
+  PRECONDITION(rEnd.timeIndex() == rSlice.timeIndex());
+  PRECONDITION(rSlice.timeIndex() >= iTime);
+  PRECONDITION(dLowerBarrier < dUpperBarrier);
+
+  unsigned iT = rSlice.timeIndex();
+  if ((iT == iTime) || (rStart.values().size() == 1) || (rEnd.values().size() == 1)) {
+    //no time elapses or the underlying does not depend on the state
+    IModel::rollback(rSlice, iTime, rStart, rEnd, dLowerBarrier, dUpperBarrier);
+    return;
+  }
+  addDependence(rSlice, rEnd.dependence());
+  std::vector<double> uBarriers(2);
+  uBarriers[0] = dLowerBarrier;
+  uBarriers[1] = dUpperBarrier;
+
+  //the payoff is knocked out at the end
+  const std::valarray<double> & rU2 = rEnd.values();
+  unsigned iSize = rU2.size();
+  ASSERT(rSlice.values().size() == iSize);
+  std::valarray<double> uInd;
+  m_uInd.indicator(rU2, uBarriers, uInd);
+  std::valarray<double> uValues(rSlice.values());
+  for (unsigned iI=0; iI<iSize; iI++) {
+    uValues[iI] *= uInd[iI] - uInd[iSize + iI];
+  }
+  double dVar = m_uTotalVar[iT] - m_uTotalVar[iTime];
+  ASSERT(dVar >= 0);
+  if (dVar == 0) {
+    dVar = c_dEps;
+  }
+  GaussRollback uRoll(m_uGaussRollback);
+  uRoll.assign(iSize, m_dH, dVar);
+  uRoll.rollback(uValues);
+
+  const std::valarray<double> & rU1 = rStart.values();
+  unsigned iSize1 = rU1.size();
+  ASSERT(iSize1 == m_uSize[iTime]);
+  ASSERT(iSize1 <= iSize);
+  unsigned iShift = (iSize-iSize1)/2;
+  ASSERT(2*iShift + iSize1 == iSize);
+  std::valarray<double> uResult(uValues[std::slice(iShift, iSize1, 1)]);
+
+  //method of images: the barrier moves linearly in the state from
+  //dX1 to dX2, then the paths from dX that cross it have the same
+  //weight as the paths from the reflected point 2*dX1 - dX,
+  //multiplied by exp(2*(dX - dX1)*(dX2 - dX1)/dVar); the second
+  //reflections are ignored for two barriers
+  for (unsigned iK=0; iK<uBarriers.size(); iK++) {
+    double dX1, dX2;
+    if (crossing(rU1, m_dH, uBarriers[iK], dX1) && 
+	crossing(rU2, m_dH, uBarriers[iK], dX2)) {
+      double dDrift = 2.*(dX2 - dX1)/dVar;
+      for (unsigned iI=0; iI<iSize1; iI++) {
+	bool bInside = (iK == 0) ? (rU1[iI] > dLowerBarrier) : (rU1[iI] < dUpperBarrier);
+	if (bInside) {
+	  double dX = (iI - 0.5*(iSize1-1))*m_dH;
+	  uResult[iI] -= std::exp(dDrift*(dX - dX1))*value(uValues, m_dH, 2.*dX1 - dX);
+	}
+      }
+    }
+  }
+
+  //the payoff is knocked out at the start
+  m_uInd.indicator(rU1, uBarriers, uInd);
+  for (unsigned iI=0; iI<iSize1; iI++) {
+    uResult[iI] *= uInd[iI] - uInd[iSize1 + iI];
+  }
+  rSlice.assign(iTime, rSlice.dependence(), uResult);
+}
+
 void cflBrownian::Model::indicator(Slice & rSlice, double dBarrier) const
 {
   std::valarray<double> uIndValues(rSlice.values());
@@ -227,11 +417,24 @@ void cflBrownian::Model::indicator(Slice & rSlice, double dBarrier) const
   rSlice.assign(uIndValues);
 }
 
+std::vector<Slice> 
+cflBrownian::Model::indicator(const Slice & rSlice, const std::vector<double> & rBarriers) const
+{
+  unsigned iSize = rSlice.values().size();
+  std::valarray<double> uInd;
+  m_uInd.indicator(rSlice.values(), rBarriers, uInd);
+  std::vector<Slice> uResult(rBarriers.size(), rSlice);
+  for (unsigned iK=0; iK<rBarriers.size(); iK++) {
+    uResult[iK].assign(std::valarray<double>(uInd[std::slice(iK*iSize, iSize, 1)]));
+  }
+  return uResult;
+}
+
 MultiFunction cflBrownian::Model::interpolate(const Slice & rSlice) const
 {
-  std::valarray<double> uArg = state(rSlice.timeIndex(), 0).values();
-  std::valarray<double> uVal = rSlice.values();
-  return toMultiFunction(m_uInterp.interpolate(&uArg[0], &uArg[0] + uArg.size(), &uVal[0]),0,1);
+  PRECONDITION(rSlice.values().size() == m_uGrid[rSlice.timeIndex()]->size());
+  return toMultiFunction(m_uInterp.interpolate(m_uGrid[rSlice.timeIndex()], 
+					       cfl::begin(rSlice.values())), 0, 1);
 }
 
 cfl::Brownian 
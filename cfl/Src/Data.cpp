@@ -1,8 +1,10 @@
 //  Copyright (c) Dmitry Kramkov, 2000-2006. All rights reserved. 
 // Implementation of classes and functions declared in the corresponding *.hpp file. 
 
+#include <cmath>
 #include <functional>
 #include <algorithm>
+#include <numeric>
 #include <limits>
 #include "cfl/Error.hpp"
 #include "cfl/Data.hpp"
@@ -16,7 +18,7 @@ namespace cflData
   {
   public:
     Discount(const Function & rYield, double dInitialTime)
-      :m_uYield(rYield), m_dInitialTime(dInitialTime) 
+      :m_uYield(compile(rYield)), m_dInitialTime(dInitialTime) 
     {}
 
     Discount(double dYield, double dInitialTime)
@@ -30,6 +32,27 @@ namespace cflData
       return dDiscount;
     }
 
+    void evaluate(const double * pT, double * pY, size_t iSize) const 
+    {
+      m_uYield.evaluate(pT, pY, iSize);
+      for (size_t iI=0; iI<iSize; iI++) {
+	ASSERT(belongs(pT[iI]));
+	pY[iI] = std::exp(-pY[iI] * (pT[iI] - m_dInitialTime));
+      }
+    }
+
+    double tangent(double dT, double * pTangent, unsigned iTangents) const 
+    {
+      ASSERT(belongs(dT));
+      double dYield = m_uYield.tangent(dT, pTangent, iTangents);
+      double dDiscount = std::exp(-dYield * (dT - m_dInitialTime));
+      double dD = -dDiscount*(dT - m_dInitialTime);
+      for (unsigned iI=0; iI<iTangents; iI++) {
+	pTangent[iI] *= dD;
+      }
+      return dDiscount;
+    }
+
     bool belongs(double  dT) const 
     { 
       bool bBelongs = (dT >= m_dInitialTime) && (m_uYield.belongs(dT));
@@ -42,6 +65,93 @@ namespace cflData
   };
 }
 
+namespace cflData 
+{
+  //log-linear discount curve
+  class LogDiscount: public IFunction
+  {
+  public:
+    LogDiscount(const std::vector<double> & rTimes, 
+		const std::vector<double> & rDiscount, double dInitialTime)
+    {
+      PRECONDITION(rTimes.size() == rDiscount.size());
+      PRECONDITION((rTimes.size() > 0) && (rTimes.front() >= dInitialTime));
+      if (rTimes.front() > dInitialTime) {
+	m_uTime.push_back(dInitialTime);
+	m_uLogDiscount.push_back(0.);
+      }
+      m_uTime.insert(m_uTime.end(), rTimes.begin(), rTimes.end());
+      for (unsigned iI=0; iI<rDiscount.size(); iI++) {
+	PRECONDITION(rDiscount[iI] > 0.);
+	m_uLogDiscount.push_back(std::log(rDiscount[iI]));
+      }
+      m_uSlope.resize(m_uTime.size(), 0.);
+      for (unsigned iI=0; iI+1<m_uTime.size(); iI++) {
+	PRECONDITION(m_uTime[iI] < m_uTime[iI+1]);
+	m_uSlope[iI] = (m_uLogDiscount[iI+1] - m_uLogDiscount[iI])/
+	  (m_uTime[iI+1] - m_uTime[iI]);
+      }
+    }
+
+    double operator()(double dT) const 
+    {
+      ASSERT(belongs(dT));
+      unsigned iI = locate(dT, 0);
+      return std::exp(m_uLogDiscount[iI] + m_uSlope[iI]*(dT - m_uTime[iI]));
+    }
+
+    void evaluate(const double * pT, double * pY, size_t iSize) const 
+    {
+      //the search starts from the previous interval; the exponents are
+      //computed in a separate loop
+      unsigned iI = 0;
+      for (size_t iJ=0; iJ<iSize; iJ++) {
+	ASSERT(belongs(pT[iJ]));
+	iI = locate(pT[iJ], iI);
+	pY[iJ] = m_uLogDiscount[iI] + m_uSlope[iI]*(pT[iJ] - m_uTime[iI]);
+      }
+      for (size_t iJ=0; iJ<iSize; iJ++) {
+	pY[iJ] = std::exp(pY[iJ]);
+      }
+    }
+
+    bool belongs(double dT) const 
+    { 
+      return (dT >= m_uTime.front()) && (dT <= m_uTime.back());
+    }
+
+  private:
+    //index of the last knot which does not exceed dT 
+    unsigned locate(double dT, unsigned iHint) const
+    {
+      if ((m_uTime[iHint] <= dT) && 
+	  ((iHint+1 == m_uTime.size()) || (dT < m_uTime[iHint+1]))) {
+	return iHint;
+      }
+      std::vector<double>::const_iterator itT = 
+	std::upper_bound(m_uTime.begin(), m_uTime.end(), dT);
+      return (itT == m_uTime.begin()) ? 0 : (itT - m_uTime.begin() - 1);
+    }
+
+    std::vector<double> m_uTime, m_uLogDiscount, m_uSlope;
+  };
+}
+
+Function cfl::Data::discount(const std::vector<double> & rTimes, 
+			     const std::vector<double> & rDiscount, double dInitialTime)
+{
+  return Function(new cflData::LogDiscount(rTimes, rDiscount, dInitialTime));
+}
+
+Function cfl::Data::tabulateDiscount(const Function & rDiscount, 
+				     const std::vector<double> & rTimes, 
+				     double dInitialTime)
+{
+  std::vector<double> uDiscount(rTimes.size());
+  rDiscount.evaluate(rTimes.data(), uDiscount.data(), uDiscount.size());
+  return discount(rTimes, uDiscount, dInitialTime);
+}
+
 Function cfl::Data::discount(double dYield, double dInitialTime) 
 {
   return Function(new cflData::Discount(dYield, dInitialTime));
@@ -81,6 +191,13 @@ namespace cflData
       return m_dSigma * std::sqrt((std::exp(dX) - 1.)/dX);
     }
 
+    void evaluate(const double * pT, double * pY, size_t iSize) const 
+    {
+      for (size_t iI=0; iI<iSize; iI++) {
+	pY[iI] = Volatility::operator()(pT[iI]);
+      }
+    }
+
     bool belongs(double  dT) const 
     { 
       return (dT >= m_dInitialTime); 
@@ -104,7 +221,8 @@ namespace cflData
   public:
     Forward(double dSpot, const cfl::Function & rCostOfCarry, 
 	    double dInitialTime)
-      :m_dSpot(dSpot), m_dInitialTime(dInitialTime), m_uCostOfCarry(rCostOfCarry)
+      :m_dSpot(dSpot), m_dInitialTime(dInitialTime), 
+       m_uCostOfCarry(compile(rCostOfCarry))
     {}
 
     Forward(double dSpot, double dCostOfCarry, double dInitialTime)
@@ -118,6 +236,27 @@ namespace cflData
       return m_dSpot*std::exp(m_uCostOfCarry(dT)*(dT-m_dInitialTime));
     }
 
+    void evaluate(const double * pT, double * pY, size_t iSize) const 
+    {
+      m_uCostOfCarry.evaluate(pT, pY, iSize);
+      for (size_t iI=0; iI<iSize; iI++) {
+	ASSERT(belongs(pT[iI]));
+	pY[iI] = m_dSpot*std::exp(pY[iI]*(pT[iI]-m_dInitialTime));
+      }
+    }
+
+    double tangent(double dT, double * pTangent, unsigned iTangents) const 
+    {
+      ASSERT(belongs(dT));
+      double dCost = m_uCostOfCarry.tangent(dT, pTangent, iTangents);
+      double dForward = m_dSpot*std::exp(dCost*(dT-m_dInitialTime));
+      double dD = dForward*(dT-m_dInitialTime);
+      for (unsigned iI=0; iI<iTangents; iI++) {
+	pTangent[iI] *= dD;
+      }
+      return dForward;
+    }
+
     bool belongs(double  dT) const 
     { 
       return (dT >= m_dInitialTime) && (m_uCostOfCarry.belongs(dT));
@@ -149,7 +288,7 @@ namespace cflData
     Forward2(double dSpot, double dDividend, const Function & rDiscount, 
 	     double dInitialTime)
       :m_dSpot(dSpot), m_dDividend(dDividend),m_dInitialTime(dInitialTime), 
-       m_uDiscount(rDiscount)
+       m_uDiscount(compile(rDiscount))
     {}
 
     bool belongs(double  dT) const 
@@ -163,6 +302,25 @@ namespace cflData
 	/m_uDiscount(dTime);
     }
 
+    void evaluate(const double * pT, double * pY, size_t iSize) const 
+    {
+      m_uDiscount.evaluate(pT, pY, iSize);
+      for (size_t iI=0; iI<iSize; iI++) {
+	pY[iI] = m_dSpot*std::exp(-m_dDividend*(pT[iI]-m_dInitialTime))/pY[iI];
+      }
+    }
+
+    double tangent(double dT, double * pTangent, unsigned iTangents) const 
+    {
+      double dDiscount = m_uDiscount.tangent(dT, pTangent, iTangents);
+      double dForward = m_dSpot*std::exp(-m_dDividend*(dT-m_dInitialTime))/dDiscount;
+      double dD = -dForward/dDiscount;
+      for (unsigned iI=0; iI<iTangents; iI++) {
+	pTangent[iI] *= dD;
+      }
+      return dForward;
+    }
+
   private:
     double m_dSpot, m_dDividend, m_dInitialTime;
     Function m_uDiscount;
@@ -208,6 +366,13 @@ namespace cflData
       return dResult;
     }
 
+    void evaluate(const double * pT, double * pY, size_t iSize) const 
+    {
+      for (size_t iI=0; iI<iSize; iI++) {
+	pY[iI] = ShapeBond::operator()(pT[iI]);
+      }
+    }
+
     bool belongs(double  dT) const 
     {
       return (dT>=m_dInitialTime);
@@ -223,10 +388,151 @@ Function cfl::Data::bondShape(double dLambda, double dInitialTime)
   return Function(new cflData::ShapeBond(dLambda, dInitialTime));
 }
 
+//least square fits
+
+namespace cflData
+{
+  //the coefficient A of the least square fit of rY by A*rX
+  double leastSquares(const std::vector<double> & rY, const std::vector<double> & rX)
+  {
+    PRECONDITION(rX.size() == rY.size());
+    double dCov = std::inner_product(rY.begin(), rY.end(), rX.begin(), 0.);
+    double dVar = std::inner_product(rX.begin(), rX.end(), rX.begin(), 0.);
+    if (!(dVar > 0.)) {
+      throw(NError::range("least square fit"));
+    }
+    return dCov/dVar;
+  }
+}
+
+Function cfl::Data::discountFit(const std::vector<double> & rTimes, 
+				const std::vector<double> & rDiscount, 
+				double dLambda, double dInitialTime)
+{
+  PRECONDITION(rTimes.size() == rDiscount.size());
+  Function uShape = bondShape(dLambda, dInitialTime);
+  std::vector<double> uShapeYield(rTimes.size());
+  uShape.evaluate(rTimes.data(), uShapeYield.data(), rTimes.size());
+  std::vector<double> uYield(rTimes.size());
+  for (unsigned iI=0; iI<rTimes.size(); iI++) {
+    PRECONDITION(rTimes[iI] > dInitialTime);
+    double dT = rTimes[iI] - dInitialTime;
+    uYield[iI] = -std::log(rDiscount[iI])/dT;
+    uShapeYield[iI] /= dT;
+  }
+  double dA = cflData::leastSquares(uYield, uShapeYield);
+  return compile(exp(-dA*uShape));
+}
+
+Function cfl::Data::volatilityFit(const std::vector<double> & rTimes, 
+				  const std::vector<double> & rVolatility, 
+				  double dLambda, double dInitialTime)
+{
+  PRECONDITION(rTimes.size() == rVolatility.size());
+  std::vector<double> uShape(rTimes.size());
+  volatility(1., -dLambda, dInitialTime).evaluate(rTimes.data(), uShape.data(), 
+						  rTimes.size());
+  double dA = cflData::leastSquares(rVolatility, uShape);
+  return volatility(dA, -dLambda, dInitialTime);
+}
+
 // CLASS: Swap
 
 cfl::Data::Swap::Swap(const CashFlow & rCashFlow, bool bPayFloat)
   :CashFlow(rCashFlow), payFloat(bPayFloat)
 {}
 
+// CLASS: Schedule
 
+cfl::Data::Schedule::Schedule(const CashFlow & rCashFlow, double dIssueTime)
+  :m_dIssueTime(dIssueTime), m_dNotional(rCashFlow.notional), m_dRate(rCashFlow.rate),
+   m_uTime(rCashFlow.numberOfPayments), m_uPeriod(rCashFlow.numberOfPayments, rCashFlow.period),
+   m_uPayment(rCashFlow.numberOfPayments, 
+	      rCashFlow.notional*rCashFlow.rate*rCashFlow.period)
+{
+  PRECONDITION((rCashFlow.numberOfPayments > 0) && (rCashFlow.period > 0.));
+  for (unsigned iI=0; iI<m_uTime.size(); iI++) {
+    m_uTime[iI] = dIssueTime + (iI+1)*rCashFlow.period;
+  }
+  m_uPayment.back() += rCashFlow.notional;
+}
+
+unsigned cfl::Data::Schedule::next(double dTime) const
+{
+  return std::upper_bound(m_uTime.begin(), m_uTime.end(), dTime) - m_uTime.begin();
+}
+
+double cfl::Data::Schedule::accruedInterest(double dTime) const
+{
+  unsigned iI = next(dTime);
+  if (iI == m_uTime.size()) {
+    return 0.;
+  }
+  double dStart = (iI == 0) ? m_dIssueTime : m_uTime[iI-1];
+  return m_dNotional*m_dRate*(dTime - dStart);
+}
+
+void cfl::Data::Schedule::forwardPrice(const Function & rDiscount, const double * pTime,
+				       double * pPrice, size_t iSize, bool bClean) const
+{
+  Data::forwardPrice(*this, rDiscount, bClean).evaluate(pTime, pPrice, iSize);
+}
+
+namespace cflData
+{
+  //forward price of coupon bond
+  class ForwardPrice: public IFunction
+  {
+  public:
+    ForwardPrice(const Data::Schedule & rSchedule, const Function & rDiscount, 
+		 bool bClean)
+      :m_uSchedule(rSchedule), m_uDiscount(rDiscount), m_bClean(bClean), 
+       m_uValue(rSchedule.paymentTimes().size() + 1, 0.)
+    {
+      //m_uValue[iI] is the value at the initial time of the payments 
+      //with indexes iI, iI+1, ... 
+      const std::vector<double> & rTime = rSchedule.paymentTimes();
+      rDiscount.evaluate(rTime.data(), m_uValue.data(), rTime.size());
+      for (unsigned iI=rTime.size(); iI>0; iI--) {
+	m_uValue[iI-1] = m_uValue[iI-1]*rSchedule.payments()[iI-1] + m_uValue[iI];
+      }
+    }
+
+    double operator()(double dT) const 
+    {
+      ASSERT(belongs(dT));
+      double dPrice = m_uValue[m_uSchedule.next(dT)]/m_uDiscount(dT);
+      return (m_bClean) ? dPrice - m_uSchedule.accruedInterest(dT) : dPrice;
+    }
+
+    void evaluate(const double * pT, double * pY, size_t iSize) const 
+    {
+      m_uDiscount.evaluate(pT, pY, iSize);
+      for (size_t iJ=0; iJ<iSize; iJ++) {
+	ASSERT(belongs(pT[iJ]));
+	pY[iJ] = m_uValue[m_uSchedule.next(pT[iJ])]/pY[iJ];
+	if (m_bClean) {
+	  pY[iJ] -= m_uSchedule.accruedInterest(pT[iJ]);
+	}
+      }
+    }
+
+    bool belongs(double dT) const 
+    { 
+      return (dT >= m_uSchedule.issueTime()) && 
+	(dT <= m_uSchedule.paymentTimes().back()) && m_uDiscount.belongs(dT);
+    }
+
+  private:
+    Data::Schedule m_uSchedule;
+    Function m_uDiscount;
+    bool m_bClean;
+    std::vector<double> m_uValue;
+  };
+}
+
+Function cfl::Data::forwardPrice(const Schedule & rSchedule,
+				 const Function & rDiscount, bool bClean)
+{
+  return Function(new cflData::ForwardPrice(rSchedule, rDiscount, bClean));
+}
@@ -64,8 +64,186 @@ unsigned cfl::Extended::addState(const PathDependent & rPathDependent)
 
 namespace cflExtended
 {
+  //methods of approximation for the path dependent state before the
+  //first reset time and after every reset time
+  std::vector<Approx> resetApprox(const PathDependent & rState, 
+				  const Approx & rApprox)
+  {
+    std::vector<Approx> uVecApprox;
+    double dLeft = rState.origin() - rState.interval()/2.;
+    double dRight = rState.origin() + rState.interval()/2.;
+    uVecApprox.push_back(rApprox);
+    uVecApprox.back().assign(dLeft,dRight);
+
+    for (unsigned iI=0; iI<rState.timeIndexes().size(); iI++) {
+      dLeft = std::numeric_limits<double>::max();
+      dRight = std::numeric_limits<double>::min();
+      for (unsigned iJ=0; iJ<uVecApprox.back().arg().size(); iJ++) {
+	std::valarray<double> uV(rState.resetValues(rState.timeIndexes()[iI], 
+						    uVecApprox.back().arg()[iJ]).values());
+	dLeft = std::min(dLeft, uV.min()); 
+	dRight = std::max(dRight, uV.max()); 
+      }
+      uVecApprox.push_back(rApprox);
+      ASSERT(dLeft <= dRight);
+      uVecApprox.back().assign(dLeft, dRight);
+    }
+    POSTCONDITION(uVecApprox.size() == rState.timeIndexes().size()+1);
+    return uVecApprox;
+  }
+
+  unsigned approxNodes(const std::vector<Approx> & rApprox)
+  {
+    unsigned iNodes = 0;
+    for (unsigned iI=0; iI<rApprox.size(); iI++) {
+      iNodes += rApprox[iI].arg().size();
+    }
+    return iNodes;
+  }
+
+  //reset values at time iTime for the nodes rArg as the columns of a matrix
+  std::valarray<double> resetMatrix(const PathDependent & rState, unsigned iTime, 
+				    const std::valarray<double> & rArg, unsigned & rColumns)
+  {
+    std::vector<Slice> uSlices;
+    std::vector<unsigned> uDepend, uTemp;
+    for (unsigned iI=0; iI<rArg.size(); iI++) {
+      uSlices.push_back(rState.resetValues(iTime, rArg[iI]));
+      uTemp.resize(uDepend.size() + uSlices.back().dependence().size());
+      uTemp.resize(std::set_union(uDepend.begin(), uDepend.end(), 
+				  uSlices.back().dependence().begin(), 
+				  uSlices.back().dependence().end(), uTemp.begin()) - 
+		   uTemp.begin());
+      uDepend.swap(uTemp);
+    }
+    rColumns = 0;
+    std::valarray<double> uValues;
+    for (unsigned iI=0; iI<uSlices.size(); iI++) {
+      uSlices[iI].ptrToModel()->addDependence(uSlices[iI], uDepend);
+      if (iI == 0) {
+	rColumns = uSlices[iI].values().size();
+	uValues.resize(rColumns*rArg.size());
+      }
+      ASSERT(uSlices[iI].values().size() == rColumns);
+      uValues[std::slice(iI*rColumns, rColumns, 1)] = uSlices[iI].values();
+    }
+    return uValues;
+  }
+
+  //returns true if the relative errors of the fits by an
+  //approximation with iN nodes of the linear and quadratic functions
+  //of the reset values do not exceed dTolerance; the exact reset
+  //values at the nodes rArg are given by rExact with iColumns
+  //columns; the approximation is returned in rCandidate
+  bool resetFits(const PathDependent & rState, unsigned iTime, 
+		 const std::valarray<double> & rArg, 
+		 const std::valarray<double> & rExact, unsigned iColumns, 
+		 unsigned iN, const Interp & rInterp, double dTolerance, 
+		 Approx & rCandidate)
+  {
+    double dLeft = rExact.min();
+    double dWidth = rExact.max() - dLeft;
+    double dCenter = dLeft + dWidth/2.;
+    rCandidate = NApprox::toApprox(Function(double(iN)), rInterp);
+    rCandidate.assign(rArg[0], rArg[rArg.size()-1]);
+    unsigned iC;
+    std::valarray<double> uValues = resetMatrix(rState, iTime, rCandidate.arg(), iC);
+    if (iC != iColumns) {
+      return false;
+    }
+    double dError = 0;
+    for (unsigned iI=0; (iI<iColumns) && (dError <= dTolerance); iI++) {
+      std::valarray<double> uLinear(uValues[std::slice(iI, iN, iColumns)]);
+      uLinear -= dCenter;
+      uLinear /= dWidth;
+      std::valarray<double> uQuadratic(uLinear*uLinear);
+      Function uFitL = rCandidate.approximate(uLinear);
+      Function uFitQ = rCandidate.approximate(uQuadratic);
+      for (unsigned iJ=0; iJ<rArg.size(); iJ++) {
+	double dY = (rExact[iJ*iColumns + iI] - dCenter)/dWidth;
+	double dE = std::abs(uFitL(rArg[iJ]) - dY) + std::abs(uFitQ(rArg[iJ]) - dY*dY);
+	dError = std::max(dError, dE);
+      }
+    }
+    return dError <= dTolerance;
+  }
+
+  //Chooses the number of nodes for every interval between reset
+  //times. The function of the state before the next reset time is
+  //the composition of the value after this reset with the reset
+  //values. The estimate does not know the value: it replaces the
+  //value after the reset by its linear and quadratic parts on the
+  //range of the next approximation and measures the errors of their
+  //fits at the nodes of the fixed policy. The first number of nodes
+  //that meets the tolerance is taken from an increasing sequence
+  //with the step of about a quarter; it never exceeds the fixed
+  //policy.
+  std::vector<Approx> adaptiveApprox(const PathDependent & rState, 
+				     const std::vector<Approx> & rFixed, 
+				     const Interp & rInterp, double dTolerance)
+  {
+    PRECONDITION(rFixed.size() == rState.timeIndexes().size()+1);
+    std::vector<Approx> uApprox(rFixed);
+    for (unsigned iK=0; iK+1<rFixed.size(); iK++) {
+      const std::valarray<double> & rArg = rFixed[iK].arg();
+      unsigned iSize = rArg.size();
+      if (iSize <= 3) {
+	continue;
+      }
+      unsigned iTime = rState.timeIndexes()[iK];
+      unsigned iColumns;
+      std::valarray<double> uExact = resetMatrix(rState, iTime, rArg, iColumns);
+      if (uExact.max() <= uExact.min()) {
+	continue;
+      }
+      //the candidates grow geometrically, so the reset values are
+      //computed for O(iSize) nodes in total
+      Approx uCandidate;
+      for (unsigned iN=3; iN<iSize; iN += std::max(1u, iN/4)) {
+	if (resetFits(rState, iTime, rArg, uExact, iColumns, iN, rInterp, 
+		      dTolerance, uCandidate)) {
+	  uApprox[iK] = uCandidate;
+	  break;
+	}
+      }
+    }
+    POSTCONDITION(uApprox.size() == rFixed.size());
+    return uApprox;
+  }
+
   // CLASS: AddState
  	
+  //indicators of a slice that does not depend on the path
+  //dependent states are computed by the base model
+  std::vector<Slice> baseIndicator(const IModel & rBase, const IModel & rModel, 
+				   const Slice & rSlice, 
+				   const std::vector<double> & rBarriers)
+  {
+    Slice uSlice(rSlice);
+    uSlice.assign(rBase);
+    std::vector<Slice> uInd = rBase.indicator(uSlice, rBarriers);
+    for (unsigned iK=0; iK<uInd.size(); iK++) {
+      uInd[iK].assign(rModel);
+    }
+    return uInd;
+  }
+
+  //rollback with barriers of the slices that do not depend on the
+  //path dependent states is performed by the base model
+  void baseRollback(const IModel & rBase, const IModel & rModel, 
+		    Slice & rSlice, unsigned iTime, 
+		    const Slice & rStart, const Slice & rEnd, 
+		    double dLowerBarrier, double dUpperBarrier)
+  {
+    Slice uStart(rStart);
+    uStart.assign(rBase);
+    Slice uEnd(rEnd);
+    uEnd.assign(rBase);
+    rSlice.assign(rBase);
+    rBase.rollback(rSlice, iTime, uStart, uEnd, dLowerBarrier, dUpperBarrier);
+    rSlice.assign(rModel);
+  }
+
   class AddState: public IModel
   {
   public:
@@ -84,10 +262,17 @@ namespace cflExtended
     void addDependence(Slice & rSlice, const std::vector<unsigned> & rDependence) const;
 		
     void rollback(Slice & rSlice, unsigned iTime) const;
+    void rollback(Slice & rSlice, unsigned iTime, 
+		  const Slice & rStart, const Slice & rEnd, 
+		  double dLowerBarrier, double dUpperBarrier) const;
 		
     void indicator(Slice & rSlice, double dBarrier) const;
+    std::vector<Slice> indicator(const Slice & rSlice, 
+				 const std::vector<double> & rBarriers) const;
 		
     MultiFunction interpolate(const Slice & rSlice) const;
+
+    unsigned numberOfApproxNodes() const { return approxNodes(m_uVecApprox); }
 		
   private:
     PathDependent m_uState;
@@ -109,28 +294,8 @@ namespace cflExtended
 	
   AddState::AddState(const cfl::PathDependent & rState, const IModel & rModel, 
 		     const Approx & rApprox)
-    :m_uState(rState), m_rModel(rModel) 
+    :m_uState(rState), m_rModel(rModel), m_uVecApprox(resetApprox(rState, rApprox)) 
   {
-    double dLeft = rState.origin() - rState.interval()/2.;
-    double dRight = rState.origin() + rState.interval()/2.;
-    m_uVecApprox.push_back(rApprox);
-    m_uVecApprox.back().assign(dLeft,dRight);
-
-		
-    for (unsigned iI=0; iI<rState.timeIndexes().size(); iI++) {
-      dLeft = std::numeric_limits<double>::max();
-      dRight = std::numeric_limits<double>::min();
-      for (unsigned iJ=0; iJ<m_uVecApprox.back().arg().size(); iJ++) {
-	std::valarray<double> uV(rState.resetValues(rState.timeIndexes()[iI], 
-						    m_uVecApprox.back().arg()[iJ]).values());
-	dLeft = std::min(dLeft, uV.min()); 
-	dRight = std::max(dRight, uV.max()); 
-      }
-      m_uVecApprox.push_back(rApprox);
-      ASSERT(dLeft <= dRight);
-      m_uVecApprox.back().assign(dLeft, dRight);
-    }
-		
     POSTCONDITION(m_uVecApprox.size() == rState.timeIndexes().size()+1);
   }
 	
@@ -328,22 +493,21 @@ namespace cflExtended
     unsigned iS1 = approxBefore(rSlice.timeIndex()).arg().size();
     ASSERT(iS0*iS1 == rSlice.values().size());
 		
-    std::valarray<double> uCondVal(rSlice.values()[std::slice(0,iS0,1)]);
-    Slice uSlice(m_rModel,rSlice.timeIndex(), uDependBegin, uCondVal);
-    uSlice.rollback(iTime);
-    unsigned iS2 = uSlice.values().size();
-    std::vector<unsigned> uDependEnd(uSlice.dependence());
+    //conditional values for all nodes of the state are rolled back at once
+    std::vector<Slice> uSlices;
+    uSlices.reserve(iS1);
+    for (unsigned iI=0; iI<iS1; iI++) {
+      std::valarray<double> uCondVal(rSlice.values()[std::slice(iI*iS0,iS0,1)]);
+      uSlices.push_back(Slice(m_rModel, rSlice.timeIndex(), uDependBegin, uCondVal));
+    }
+    m_rModel.rollback(uSlices, iTime);
+    unsigned iS2 = uSlices.front().values().size();
+    std::vector<unsigned> uDependEnd(uSlices.front().dependence());
     ASSERT(iS2 == m_rModel.numberOfNodes(iTime, uDependEnd));
     std::valarray<double> uValues(iS2*iS1);
-    uValues[std::slice(0,iS2,1)] = uSlice.values();
-		
-    for (unsigned iI=1; iI<iS1; iI++) {
-      ASSERT(uCondVal.size() == iS0);
-      uCondVal = rSlice.values()[std::slice(iI*iS0,iS0,1)];
-      uSlice.assign(rSlice.timeIndex(), uDependBegin, uCondVal);
-      uSlice.rollback(iTime);
-      ASSERT(uSlice.values().size() == iS2);
-      uValues[std::slice(iI*iS2, iS2, 1)] = uSlice.values();
+    for (unsigned iI=0; iI<iS1; iI++) {
+      ASSERT(uSlices[iI].values().size() == iS2);
+      uValues[std::slice(iI*iS2, iS2, 1)] = uSlices[iI].values();
     }
 		
     if (std::binary_search(m_uState.timeIndexes().begin(), 
@@ -370,6 +534,7 @@ namespace cflExtended
       iS2 = m_rModel.numberOfNodes(iTime, uDependEnd);
       std::valarray<double> uV(uValues);
       uValues.resize(iS2*iS1);
+      Slice uSlice(uSlices.front());
       ASSERT(uSlice.timeIndex() == iTime);
       for (unsigned iI=0; iI<iS1; iI++) {
 	uSlice.assign(uD, std::valarray<double>(uV[std::slice(iI*iS,iS,1)]));
@@ -382,18 +547,28 @@ namespace cflExtended
     unsigned iS3 = approxBefore(iTime).arg().size();
     ASSERT(iS3*iS2 == numberOfNodes(iTime, uState.dependence()));
     std::valarray<double> uV(uState.values().size());
-    unsigned iJ;
-    for (unsigned iI=0; iI<iS2; iI++) {
-      ASSERT(uValues.size() == iS1*iS2);
-      Function uApprox = 
-	rApprox.approximate(std::valarray<double>(uValues[std::slice(iI,iS1,iS2)]));
-      for (iJ=iI; iJ<uV.size(); iJ+=iS2) {
-	uV[iJ] = uApprox(uState.values()[iJ]);
-      }
-    }
+    ASSERT(uValues.size() == iS1*iS2);
+    ASSERT(uV.size() == iS2*iS3);
+    rApprox.approximate(&uValues[0], iS2, &uState.values()[0], iS3, &uV[0]);
     rSlice.assign(iTime, uState.dependence(), uV);
   }
 
+  void AddState::rollback(Slice & rSlice, unsigned iTime, 
+			  const Slice & rStart, const Slice & rEnd, 
+			  double dLowerBarrier, double dUpperBarrier) const
+  {
+    unsigned iBase = m_rModel.numberOfStates();
+    if (((rSlice.dependence().size() == 0) || (rSlice.dependence().back() < iBase)) &&
+	((rStart.dependence().size() == 0) || (rStart.dependence().back() < iBase)) &&
+	((rEnd.dependence().size() == 0) || (rEnd.dependence().back() < iBase))) {
+      baseRollback(m_rModel, *this, rSlice, iTime, rStart, rEnd, 
+		   dLowerBarrier, dUpperBarrier);
+      return;
+    }
+    //the barriers are monitored only at the two event times
+    IModel::rollback(rSlice, iTime, rStart, rEnd, dLowerBarrier, dUpperBarrier);
+  }
+
   void AddState::indicator(Slice & rSlice, double dBarrier) const 
   {
     if ((rSlice.dependence().size() ==0)||
@@ -423,6 +598,16 @@ namespace cflExtended
     }
   }
 
+  std::vector<Slice> 
+  AddState::indicator(const Slice & rSlice, const std::vector<double> & rBarriers) const 
+  {
+    if ((rSlice.dependence().size() ==0)||
+	(rSlice.dependence().back() < m_rModel.numberOfStates())) {
+      return baseIndicator(m_rModel, *this, rSlice, rBarriers);
+    }
+    return IModel::indicator(rSlice, rBarriers);
+  }
+
   class MFunc: public IMultiFunction
   {
   public:
@@ -436,14 +621,14 @@ namespace cflExtended
     bool belongs(const std::valarray<double> & rX) const 
     {
       PRECONDITION(rX.size() == dim());
-      double dY = rX[rX.size()-1];
-      bool bResult = m_uBelong.belongs(dY);
+      return belongs(cfl::begin(rX));
+    }
 
-      if (bResult) {
-	std::valarray<double> uV(rX[std::slice(0,rX.size()-1,1)]);
-	bResult = m_uVecFunc.front().belongs(uV);
-      }
-      return bResult;
+    //the first dim()-1 coordinates of pX are the argument of the
+    //functions in m_uVecFunc
+    bool belongs(const double * pX) const 
+    {
+      return m_uBelong.belongs(pX[dim()-1]) && m_uVecFunc.front().belongs(pX);
     }
 
     unsigned dim() const 
@@ -455,16 +640,22 @@ namespace cflExtended
     double operator()(const std::valarray<double> & rX) const 
     {
       PRECONDITION(rX.size() == dim());
-      std::valarray<double> uY(rX[std::slice(0, rX.size()-1,1)]);
-      std::valarray<double> uV(m_uVecFunc.size());
-      for (unsigned iI=0; iI<uV.size(); iI++) {
-	uV[iI] = m_uVecFunc[iI](uY);
-      }
+      return (*this)(cfl::begin(rX));
+    }
 
-      return m_uApprox.approximate(uV)(rX[rX.size()-1]);
+    double operator()(const double * pX) const 
+    {
+      Scratch<c_iScratch> uV(m_uVecFunc.size());
+      for (unsigned iI=0; iI<m_uVecFunc.size(); iI++) {
+	uV.begin()[iI] = m_uVecFunc[iI](pX);
+      }
+      double dResult;
+      m_uApprox.approximate(uV.begin(), 1, pX + dim() - 1, 1, &dResult);
+      return dResult;
     }
 
   private:
+    static const unsigned c_iScratch = 64;
     Approx m_uApprox;
     std::vector<MultiFunction> m_uVecFunc;
     Function m_uBelong;
@@ -501,6 +692,520 @@ namespace cflExtended
     return MultiFunction(new MFunc(rApprox,uVecFunc));
   }
 
+  // CLASS: Flat
+
+  //All path dependent states are kept as the axes of one tensor. The
+  //nodes of the original model run fastest, they are followed by the
+  //nodes of path dependent states in the order of their indexes. This
+  //is the same layout of values as for the nested AddState models. 
+
+  class Flat: public IModel
+  {
+  public:
+    Flat(const PathDependent & rState, const IModel & rModel, 
+	 const std::vector<Approx> & rApprox, unsigned iFixedNodes);
+    
+    Flat(const PathDependent & rState, const Flat & rFlat, 
+	 const std::vector<Approx> & rApprox, unsigned iFixedNodes);
+
+    const std::vector<double> & eventTimes() const { return m_rModel.eventTimes(); }
+		
+    unsigned numberOfStates() const 
+    { 
+      return m_rModel.numberOfStates() + m_uStates.size(); 
+    }
+		
+    std::valarray<double> origin() const;
+
+    Slice state(unsigned iTime, unsigned iState) const;
+		
+    unsigned numberOfNodes(unsigned iTime,  const std::vector<unsigned> & rDependence) const;
+		
+    void addDependence(Slice & rSlice, const std::vector<unsigned> & rDependence) const;
+		
+    void rollback(Slice & rSlice, unsigned iTime) const;
+    void rollback(Slice & rSlice, unsigned iTime, 
+		  const Slice & rStart, const Slice & rEnd, 
+		  double dLowerBarrier, double dUpperBarrier) const;
+		
+    void indicator(Slice & rSlice, double dBarrier) const;
+    std::vector<Slice> indicator(const Slice & rSlice, 
+				 const std::vector<double> & rBarriers) const;
+		
+    MultiFunction interpolate(const Slice & rSlice) const;
+
+    unsigned numberOfPathStates() const { return m_uStates.size(); }
+
+    unsigned numberOfApproxNodes(bool bFixedPolicy) const 
+    { 
+      if (bFixedPolicy) {
+	return m_iFixedNodes;
+      }
+      unsigned iNodes = 0;
+      for (unsigned iK=0; iK<m_uApprox.size(); iK++) {
+	iNodes += approxNodes(m_uApprox[iK]);
+      }
+      return iNodes;
+    }
+
+  private:
+    const IModel & m_rModel;
+    std::vector<PathDependent> m_uStates;
+    //methods of approximation for every path dependent state 
+    std::vector<std::vector<Approx> > m_uApprox;
+    //the number of nodes under the fixed policy
+    unsigned m_iFixedNodes;
+
+    const Approx & approxBefore(unsigned iState, unsigned iTime) const 
+    {
+      ASSERT(iState >= m_rModel.numberOfStates());
+      unsigned iK = iState - m_rModel.numberOfStates();
+      ASSERT(iK < m_uStates.size());
+      const std::vector<unsigned> & rTimes = m_uStates[iK].timeIndexes();
+      unsigned iI = std::lower_bound(rTimes.begin(), rTimes.end(), iTime) - rTimes.begin();
+      ASSERT(iI < m_uApprox[iK].size());
+      return m_uApprox[iK][iI];
+    }
+
+    bool isResetTime(unsigned iState, unsigned iTime) const
+    {
+      const std::vector<unsigned> & rTimes = 
+	m_uStates[iState - m_rModel.numberOfStates()].timeIndexes();
+      return std::binary_search(rTimes.begin(), rTimes.end(), iTime);
+    }
+
+    std::vector<unsigned>::const_iterator 
+    firstPathState(const std::vector<unsigned> & rDependence) const 
+    {
+      return std::lower_bound(rDependence.begin(), rDependence.end(), 
+			      m_rModel.numberOfStates());
+    }
+
+    std::valarray<double> expand(unsigned iTime, const std::valarray<double> & rValues, 
+				 const std::vector<unsigned> & rFrom, 
+				 const std::vector<unsigned> & rTo, 
+				 const std::vector<unsigned> & rSizes) const;
+
+    void oneStepRollback(Slice & rSlice, unsigned iTime) const;
+
+    MultiFunction interpolate(unsigned iTime, const std::vector<unsigned> & rDependence, 
+			      const std::valarray<double> & rValues) const;
+  };
+
+  Flat::Flat(const PathDependent & rState, const IModel & rModel, 
+	     const std::vector<Approx> & rApprox, unsigned iFixedNodes)
+    :m_rModel(rModel), m_uStates(1, rState), m_uApprox(1, rApprox), 
+     m_iFixedNodes(iFixedNodes)
+  {
+    PRECONDITION(rApprox.size() == rState.timeIndexes().size()+1);
+  }
+
+  Flat::Flat(const PathDependent & rState, const Flat & rFlat, 
+	     const std::vector<Approx> & rApprox, unsigned iFixedNodes)
+    :m_rModel(rFlat.m_rModel), m_uStates(rFlat.m_uStates), m_uApprox(rFlat.m_uApprox), 
+     m_iFixedNodes(rFlat.m_iFixedNodes + iFixedNodes)
+  {
+    PRECONDITION(rApprox.size() == rState.timeIndexes().size()+1);
+    m_uStates.push_back(rState);
+    m_uApprox.push_back(rApprox);
+  }
+
+  std::valarray<double> Flat::origin() const 
+  {
+    std::valarray<double> uOrigin(numberOfStates());
+    uOrigin[std::slice(0, m_rModel.numberOfStates(),1)] = m_rModel.origin();
+    for (unsigned iK=0; iK<m_uStates.size(); iK++) {
+      uOrigin[m_rModel.numberOfStates()+iK] = m_uStates[iK].origin();
+    }
+    return uOrigin;
+  }	
+
+  unsigned Flat::numberOfNodes(unsigned iTime, const std::vector<unsigned> & rDependence) const 
+  {
+    std::vector<unsigned>::const_iterator itI = firstPathState(rDependence);
+    unsigned iN = m_rModel.numberOfNodes(iTime, std::vector<unsigned>(rDependence.begin(), itI));
+    for (; itI<rDependence.end(); itI++) {
+      iN *= approxBefore(*itI, iTime).arg().size();
+    }
+    return iN;
+  }
+
+  Slice Flat::state(unsigned iTime, unsigned iState) const 
+  {
+    ASSERT(iTime < eventTimes().size());
+    ASSERT(iState < numberOfStates());
+
+    if (iState < m_rModel.numberOfStates()) { //state of the original model
+      Slice uState = m_rModel.state(iTime, iState);
+      uState.assign(*this);
+      return uState;
+    }
+
+    const Approx & rApprox = approxBefore(iState, iTime);
+    std::vector<unsigned> uDepend(0); 
+    std::valarray<double> uValues(0); 
+		
+    if (isResetTime(iState, iTime)) {
+      const PathDependent & rPathState = m_uStates[iState - m_rModel.numberOfStates()];
+      std::vector<Slice> uSlices;
+      std::vector<unsigned> uTemp(numberOfStates());				
+      for (unsigned iI=0; iI<rApprox.arg().size(); iI++) {
+	uSlices.push_back(rPathState.resetValues(iTime, rApprox.arg()[iI]));
+	std::vector<unsigned>::iterator itI = 
+	  std::set_union(uDepend.begin(), uDepend.end(), 
+			 uSlices.back().dependence().begin(), 
+			 uSlices.back().dependence().end(), uTemp.begin());
+	uDepend.assign(uTemp.begin(), itI);
+      }
+      ASSERT((uDepend.size()==0) || (uDepend.back() < iState));
+			
+      unsigned iS0 = numberOfNodes(iTime, uDepend);
+      unsigned iS1 = rApprox.arg().size();
+      uValues.resize(iS0*iS1);
+      for (unsigned iI=0; iI<iS1; iI++) {
+	uSlices[iI].assign(*this);
+	addDependence(uSlices[iI], uDepend);
+	ASSERT(uSlices[iI].values().size() == iS0);
+	uValues[std::slice(iI*iS0,iS0,1)] = uSlices[iI].values();
+      }
+    }
+    else {
+      uValues.resize(rApprox.arg().size());
+      uValues = rApprox.arg();
+    }
+    uDepend.push_back(iState);
+    return Slice(*this, iTime, uDepend, uValues);
+  }
+
+  //extends the values rValues with the dependence rFrom to the values
+  //with the dependence rTo; rSizes are the numbers of nodes for the
+  //path dependent states from rTo
+  std::valarray<double> Flat::expand(unsigned iTime, const std::valarray<double> & rValues, 
+				     const std::vector<unsigned> & rFrom, 
+				     const std::vector<unsigned> & rTo, 
+				     const std::vector<unsigned> & rSizes) const
+  {
+    PRECONDITION(std::includes(rTo.begin(), rTo.end(), rFrom.begin(), rFrom.end()));
+
+    std::vector<unsigned>::const_iterator itFrom = firstPathState(rFrom);
+    std::vector<unsigned>::const_iterator itTo = firstPathState(rTo);
+    ASSERT(rSizes.size() == unsigned(rTo.end() - itTo));
+    std::vector<unsigned> uBaseFrom(rFrom.begin(), itFrom);
+    std::vector<unsigned> uBaseTo(rTo.begin(), itTo);
+    unsigned iS0 = m_rModel.numberOfNodes(iTime, uBaseFrom);
+    unsigned iS1 = m_rModel.numberOfNodes(iTime, uBaseTo);
+    unsigned iBlocks = rValues.size()/iS0;
+    ASSERT(iBlocks*iS0 == rValues.size());
+
+    //dependence on the states of the original model
+    std::valarray<double> uValues(rValues);
+    if (uBaseFrom.size() < uBaseTo.size()) {
+      uValues.resize(iS1*iBlocks);
+      Slice uSlice(&m_rModel, iTime, 0.);
+      for (unsigned iI=0; iI<iBlocks; iI++) {
+	uSlice.assign(uBaseFrom, std::valarray<double>(rValues[std::slice(iI*iS0,iS0,1)]));
+	m_rModel.addDependence(uSlice, uBaseTo);
+	ASSERT(uSlice.values().size() == iS1);
+	uValues[std::slice(iI*iS1,iS1,1)] = uSlice.values();
+      }
+    }
+    if (rFrom.end() - itFrom == rTo.end() - itTo) {
+      return uValues;
+    }
+
+    //dependence on path dependent states: the blocks of the original
+    //model are copied; uStride[iK] is the step in uValues for the
+    //state *(itTo+iK) (zero if uValues do not depend on it)
+    std::vector<unsigned> uStride(rSizes.size(), 0);
+    unsigned iStride = iS1;
+    unsigned iCount = 1;
+    for (unsigned iK=0; iK<rSizes.size(); iK++) {
+      if ((itFrom < rFrom.end()) && (*itFrom == *(itTo+iK))) {
+	uStride[iK] = iStride;
+	iStride *= rSizes[iK];
+	itFrom++;
+      }
+      iCount *= rSizes[iK];
+    }
+    ASSERT(itFrom == rFrom.end());
+    ASSERT(iStride == uValues.size());
+
+    std::valarray<double> uResult(iS1*iCount);
+    std::vector<unsigned> uIndex(rSizes.size(), 0);
+    unsigned iSource = 0;
+    for (unsigned iI=0; iI<iCount; iI++) {
+      uResult[std::slice(iI*iS1,iS1,1)] = uValues[std::slice(iSource,iS1,1)];
+      for (unsigned iK=0; iK<uIndex.size(); iK++) {
+	uIndex[iK]++;
+	iSource += uStride[iK];
+	if (uIndex[iK] < rSizes[iK]) {
+	  break;
+	}
+	iSource -= uIndex[iK]*uStride[iK];
+	uIndex[iK] = 0;
+      }
+    }
+    return uResult;
+  }
+
+  void Flat::addDependence(Slice & rSlice, const std::vector<unsigned> & rDependence) const 
+  {
+    PRECONDITION(rSlice.ptrToModel() == this);
+
+    if (std::includes(rSlice.dependence().begin(), rSlice.dependence().end(), 
+		      rDependence.begin(), rDependence.end())) { 
+      return;
+    }
+		
+    std::vector<unsigned> uUnion(numberOfStates());
+    unsigned iUnionSize = 
+      std::set_union(rSlice.dependence().begin(), rSlice.dependence().end(), 
+		     rDependence.begin(), rDependence.end(), uUnion.begin()) - uUnion.begin();
+    uUnion.resize(iUnionSize);
+
+    if (rSlice.values().size() == numberOfNodes(rSlice.timeIndex(), uUnion)) {
+      //artificial extension
+      rSlice.assign(uUnion, rSlice.values());
+      return;
+    }
+
+    std::vector<unsigned> uSizes;
+    for (std::vector<unsigned>::const_iterator itI = firstPathState(uUnion); 
+	 itI < uUnion.end(); itI++) {
+      uSizes.push_back(approxBefore(*itI, rSlice.timeIndex()).arg().size());
+    }
+    rSlice.assign(uUnion, expand(rSlice.timeIndex(), rSlice.values(), 
+				 rSlice.dependence(), uUnion, uSizes));
+  }
+
+  void Flat::rollback(Slice & rSlice, unsigned iTime) const 
+  {
+    ASSERT(rSlice.timeIndex() >= iTime);
+    while (rSlice.timeIndex() > iTime) {
+      std::vector<unsigned>::const_iterator itI = firstPathState(rSlice.dependence());
+      if (itI == rSlice.dependence().end()) {
+	rSlice.assign(m_rModel);
+	rSlice.rollback(iTime);
+	rSlice.assign(*this);
+	return;
+      }
+      //the last reset time before the current time for the
+      //path dependent states of rSlice
+      unsigned iStop = iTime;
+      for (; itI < rSlice.dependence().end(); itI++) {
+	const std::vector<unsigned> & rTimes = 
+	  m_uStates[*itI - m_rModel.numberOfStates()].timeIndexes();
+	std::vector<unsigned>::const_iterator itT = 
+	  std::lower_bound(rTimes.begin(), rTimes.end(), rSlice.timeIndex());
+	if ((itT > rTimes.begin()) && (*(itT-1) > iStop)) {
+	  iStop = *(itT-1);
+	}
+      }
+      oneStepRollback(rSlice, iStop);
+    }
+  }
+
+  void Flat::oneStepRollback(Slice & rSlice, unsigned iTime) const 
+  {
+    ASSERT(rSlice.timeIndex() > iTime);
+    unsigned iT = rSlice.timeIndex();
+    std::vector<unsigned>::const_iterator itI = firstPathState(rSlice.dependence());
+    std::vector<unsigned> uBase(rSlice.dependence().begin(), itI);
+    std::vector<unsigned> uPath(itI, rSlice.dependence().end());
+    unsigned iS0 = m_rModel.numberOfNodes(iT, uBase);
+    unsigned iS1 = rSlice.values().size()/iS0;
+    ASSERT(iS0*iS1 == rSlice.values().size());
+
+    //rollback in the original model for all nodes of path dependent
+    //states at once
+    std::vector<Slice> uSlices(iS1, Slice(&m_rModel, iT, 0.));
+    for (unsigned iI=0; iI<iS1; iI++) {
+      uSlices[iI].assign(iT, uBase, std::valarray<double>(rSlice.values()[std::slice(iI*iS0,iS0,1)]));
+    }
+    m_rModel.rollback(uSlices, iTime);
+    std::vector<unsigned> uDepend = uSlices.front().dependence();
+    unsigned iS2 = uSlices.front().values().size();
+    std::valarray<double> uValues(iS2*iS1);
+    for (unsigned iI=0; iI<iS1; iI++) {
+      ASSERT(uSlices[iI].values().size() == iS2);
+      uValues[std::slice(iI*iS2,iS2,1)] = uSlices[iI].values();
+    }
+    uDepend.insert(uDepend.end(), uPath.begin(), uPath.end());
+
+    //resets of path dependent states in the order of their indexes
+    for (unsigned iK=0; iK<uPath.size(); iK++) {
+      unsigned iState = uPath[iK];
+      if (!isResetTime(iState, iTime)) {
+	continue;
+      }
+      Slice uState = state(iTime, iState);
+      std::vector<unsigned> uUnion(numberOfStates());
+      uUnion.resize(std::set_union(uDepend.begin(), uDepend.end(), 
+				   uState.dependence().begin(), uState.dependence().end(), 
+				   uUnion.begin()) - uUnion.begin());
+      //the states with indexes >= iState have not been reset yet 
+      std::vector<unsigned>::const_iterator itJ = firstPathState(uUnion);
+      std::vector<unsigned> uSizesBefore, uSizesAfter;
+      unsigned iInner = 
+	m_rModel.numberOfNodes(iTime, std::vector<unsigned>(uUnion.cbegin(), itJ));
+      unsigned iOuter = 1;
+      for (; itJ < uUnion.end(); itJ++) {
+	unsigned iSize = approxBefore(*itJ, (*itJ < iState) ? iTime : iT).arg().size();
+	uSizesAfter.push_back(iSize);
+	uSizesBefore.push_back((*itJ == iState) ? approxBefore(iState, iTime).arg().size() : iSize);
+	if (*itJ < iState) {
+	  iInner *= iSize;
+	}
+	else if (*itJ > iState) {
+	  iOuter *= iSize;
+	}
+      }
+      std::valarray<double> uAfter = expand(iTime, uValues, uDepend, uUnion, uSizesAfter);
+      std::valarray<double> uBefore = expand(iTime, uState.values(), uState.dependence(), 
+					     uUnion, uSizesBefore);
+      const Approx & rApprox = approxBefore(iState, iT);
+      unsigned iN = rApprox.arg().size();
+      unsigned iM = approxBefore(iState, iTime).arg().size();
+      ASSERT(uAfter.size() == iInner*iN*iOuter);
+      ASSERT(uBefore.size() == iInner*iM*iOuter);
+      uValues.resize(uBefore.size());
+      for (unsigned iO=0; iO<iOuter; iO++) {
+	rApprox.approximate(&uAfter[iInner*iN*iO], iInner, 
+			    &uBefore[iInner*iM*iO], iM, &uValues[iInner*iM*iO]);
+      }
+      uDepend = uUnion;
+    }
+    rSlice.assign(iTime, uDepend, uValues);
+  }
+
+  void Flat::rollback(Slice & rSlice, unsigned iTime, 
+		      const Slice & rStart, const Slice & rEnd, 
+		      double dLowerBarrier, double dUpperBarrier) const
+  {
+    if ((firstPathState(rSlice.dependence()) == rSlice.dependence().end()) &&
+	(firstPathState(rStart.dependence()) == rStart.dependence().end()) &&
+	(firstPathState(rEnd.dependence()) == rEnd.dependence().end())) {
+      baseRollback(m_rModel, *this, rSlice, iTime, rStart, rEnd, 
+		   dLowerBarrier, dUpperBarrier);
+      return;
+    }
+    //the barriers are monitored only at the two event times
+    IModel::rollback(rSlice, iTime, rStart, rEnd, dLowerBarrier, dUpperBarrier);
+  }
+
+  void Flat::indicator(Slice & rSlice, double dBarrier) const 
+  {
+    std::vector<unsigned>::const_iterator itI = firstPathState(rSlice.dependence());
+    if (itI == rSlice.dependence().end()) {
+      rSlice.assign(m_rModel);
+      m_rModel.indicator(rSlice, dBarrier);
+      rSlice.assign(*this);
+      return;
+    }
+    std::vector<unsigned> uBase(rSlice.dependence().begin(), itI);
+    unsigned iS0 = m_rModel.numberOfNodes(rSlice.timeIndex(), uBase);
+    unsigned iS1 = rSlice.values().size()/iS0;
+    ASSERT(rSlice.values().size() == iS0*iS1);
+
+    std::valarray<double> uValues(rSlice.values().size());
+    std::valarray<double> uVal(iS0);
+    Slice uSlice(m_rModel, rSlice.timeIndex(), uBase, uVal);
+    for (unsigned iI=0; iI<iS1; iI++) {
+      uVal = rSlice.values()[std::slice(iI*iS0,iS0,1)];
+      uSlice.assign(uVal); 
+      m_rModel.indicator(uSlice, dBarrier);	
+      uValues[std::slice(iI*iS0,iS0,1)] = uSlice.values();
+    }
+    rSlice.assign(uValues);
+  }
+
+  std::vector<Slice> 
+  Flat::indicator(const Slice & rSlice, const std::vector<double> & rBarriers) const 
+  {
+    if (firstPathState(rSlice.dependence()) == rSlice.dependence().end()) {
+      return baseIndicator(m_rModel, *this, rSlice, rBarriers);
+    }
+    return IModel::indicator(rSlice, rBarriers);
+  }
+
+  MultiFunction Flat::interpolate(unsigned iTime, const std::vector<unsigned> & rDependence, 
+				  const std::valarray<double> & rValues) const
+  {
+    if ((rDependence.size() == 0) || (rDependence.back() < m_rModel.numberOfStates())) {
+      return m_rModel.interpolate(Slice(m_rModel, iTime, rDependence, rValues));
+    }
+    const Approx & rApprox = approxBefore(rDependence.back(), iTime);
+    if (rDependence.size() == 1) {
+      ASSERT(rValues.size() == rApprox.arg().size());
+      return toMultiFunction(rApprox.approximate(rValues), 0, 1);
+    }
+    std::vector<unsigned> uDep(rDependence.begin(), rDependence.end()-1);
+    unsigned iS1 = rApprox.arg().size();
+    unsigned iS0 = rValues.size()/iS1;
+    ASSERT(iS0*iS1 == rValues.size());
+    std::vector<MultiFunction> uVecFunc;
+    for (unsigned iI=0; iI<iS1; iI++) {
+      uVecFunc.push_back(interpolate(iTime, uDep, 
+				     std::valarray<double>(rValues[std::slice(iI*iS0,iS0,1)])));
+    }
+    return MultiFunction(new MFunc(rApprox,uVecFunc));
+  }
+
+  MultiFunction Flat::interpolate(const Slice & rSlice) const
+  {
+    PRECONDITION(rSlice.ptrToModel() == this);
+    return interpolate(rSlice.timeIndex(), rSlice.dependence(), rSlice.values());
+  }
+
+  class FlatExtend: public IExtend
+  {
+  public:
+    FlatExtend(const std::vector<Approx> & rApprox)
+      :m_uApprox(rApprox)
+    {
+      PRECONDITION(rApprox.size() > 0);
+    }
+
+    IModel * newModel(const PathDependent & rState, const IModel & rModel) const 
+    {
+      const Flat * pFlat = dynamic_cast<const Flat *>(&rModel);
+      unsigned iK = (pFlat == 0) ? 0 : pFlat->numberOfPathStates();
+      const Approx & rApprox = m_uApprox[std::min<unsigned>(iK, m_uApprox.size()-1)];
+      std::vector<Approx> uApprox = resetApprox(rState, rApprox);
+      if (pFlat == 0) {
+	return new Flat(rState, rModel, uApprox, approxNodes(uApprox));
+      }
+      return new Flat(rState, *pFlat, uApprox, approxNodes(uApprox));
+    }
+  private:
+    std::vector<Approx> m_uApprox;
+  };
+
+  class AdaptiveExtend: public IExtend
+  {
+  public:
+    AdaptiveExtend(const Approx & rApprox, const Interp & rInterp, double dTolerance)
+      :m_uApprox(rApprox), m_uInterp(rInterp), m_dTolerance(dTolerance)
+    {
+      PRECONDITION(dTolerance > 0);
+    }
+
+    IModel * newModel(const PathDependent & rState, const IModel & rModel) const 
+    {
+      std::vector<Approx> uFixed = resetApprox(rState, m_uApprox);
+      std::vector<Approx> uApprox = adaptiveApprox(rState, uFixed, m_uInterp, m_dTolerance);
+      const Flat * pFlat = dynamic_cast<const Flat *>(&rModel);
+      if (pFlat == 0) {
+	return new Flat(rState, rModel, uApprox, approxNodes(uFixed));
+      }
+      return new Flat(rState, *pFlat, uApprox, approxNodes(uFixed));
+    }
+  private:
+    Approx m_uApprox;
+    Interp m_uInterp;
+    double m_dTolerance;
+  };
+
   class Extend: public IExtend
   {
   public:
@@ -561,16 +1266,68 @@ namespace cflExtended
   };
 }
 
-cfl::Extended cfl::NExtended::model(const std::vector<double> & rQuality)
+namespace cflExtended
 {
-  std::vector<Approx> uApprox(0);
-  Interp uSpline = NInterp::spline();
+  std::vector<Approx> defaultApprox(const std::vector<double> & rQuality)
+  {
+    std::vector<Approx> uApprox(0);
+    Interp uSpline = NInterp::fastSpline();
   
-  for (unsigned iI=0; iI<rQuality.size(); iI++) {
-    Function uSize(new cflExtended::Size(rQuality[iI]));
-    uApprox.push_back(cfl::NApprox::toApprox(uSize, uSpline));
+    for (unsigned iI=0; iI<rQuality.size(); iI++) {
+      Function uSize(new cflExtended::Size(rQuality[iI]));
+      uApprox.push_back(cfl::NApprox::toApprox(uSize, uSpline));
+    }
+    return uApprox;
   }
+}
+
+cfl::Extended cfl::NExtended::model(const std::vector<double> & rQuality)
+{
+  return model(cflExtended::defaultApprox(rQuality));
+}
+
+cfl::Extended cfl::NExtended::flat(const std::vector<Approx> & rApprox) 
+{
+  PRECONDITION(rApprox.size()>0);
+  return Extended(new cflExtended::FlatExtend(rApprox));
+}
 
-  return model(uApprox);
+cfl::Extended cfl::NExtended::flat(const std::vector<double> & rQuality)
+{
+  return flat(cflExtended::defaultApprox(rQuality));
 }
 
+cfl::Extended cfl::NExtended::adaptive(double dQuality, double dTolerance)
+{
+  Function uSize(new cflExtended::Size(dQuality));
+  Interp uSpline = NInterp::fastSpline();
+  return Extended(new cflExtended::AdaptiveExtend(NApprox::toApprox(uSize, uSpline), 
+						  uSpline, dTolerance));
+}
+
+unsigned cfl::Extended::numberOfApproxNodes(bool bFixedPolicy) const
+{
+  //a flat model contains the states of the flat models before it,
+  //hence only the last model of a sequence of flat models is
+  //counted; the models created by other extensions are skipped
+  unsigned iNodes = 0;
+  bool bFlat = false;
+  for (unsigned iI=m_uModels.size(); iI>0; iI--) {
+    const IModel * pModel = m_uModels[iI-1].get();
+    const cflExtended::Flat * pFlat = dynamic_cast<const cflExtended::Flat *>(pModel);
+    if (pFlat) {
+      if (!bFlat) {
+	iNodes += pFlat->numberOfApproxNodes(bFixedPolicy);
+      }
+      bFlat = true;
+      continue;
+    }
+    bFlat = false;
+    const cflExtended::AddState * pAdd = 
+      dynamic_cast<const cflExtended::AddState *>(pModel);
+    if (pAdd) {
+      iNodes += pAdd->numberOfApproxNodes();
+    }
+  }
+  return iNodes;
+}
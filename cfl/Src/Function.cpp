@@ -3,6 +3,8 @@
 
 #include <cmath>
 #include <limits>
+#include <algorithm>
+#include <vector>
 #include "cfl/Function.hpp"
 #include "cfl/Auxiliary.hpp"
 #include "cfl/MultiFunction.hpp"
@@ -11,12 +13,92 @@
 using namespace cfl;
 using namespace std;
 
+// CLASS: IFunction
+
+void cfl::IFunction::evaluate(const double * pX, double * pY, size_t iSize) const
+{
+  for (size_t iI=0; iI<iSize; iI++) {
+    pY[iI] = operator()(pX[iI]);
+  }
+}
+
+double cfl::IFunction::tangent(double dX, double * pTangent, unsigned iTangents) const
+{
+  std::fill(pTangent, pTangent + iTangents, 0.);
+  return operator()(dX);
+}
+
 cfl::Function::Function(IFunction * pNewP)
   : m_pF(pNewP)
 {}
 
 namespace cflFunction
 {
+  //Elementary operations recognized by cfl::compile. The constant
+  //argument c of an operation with a number is stored separately.
+  enum Op { eLeaf, eConst, eOpaque, 
+	    eNeg, eAbs, eExp, eLog, eSqrt, 
+	    eAddC, eSubC, eCSub, eMulC, eDivC, eCDiv, eMaxC, eMinC, ePowC, 
+	    eAdd, eSub, eMul, eDiv, eMax, eMin };
+
+  //derivative at dY of the unary operation with the code eOp
+  inline double derivative(Op eOp, double dArg, double dY)
+  {
+    switch (eOp) {
+    case eNeg: return -1.;
+    case eAbs: return (dY < 0.) ? -1. : 1.;
+    case eExp: return std::exp(dY);
+    case eLog: return 1./dY;
+    case eSqrt: return 0.5/std::sqrt(dY);
+    case eAddC: case eSubC: return 1.;
+    case eCSub: return -1.;
+    case eMulC: return dArg;
+    case eDivC: return 1./dArg;
+    case eCDiv: return -dArg/(dY*dY);
+    case eMaxC: return (dArg < dY) ? 1. : 0.;
+    case eMinC: return (dY < dArg) ? 1. : 0.;
+    case ePowC: return dArg*std::pow(dY, dArg-1.);
+    default: ASSERT(false); return 0.;
+    }
+  }
+
+  //partial derivatives at (dY1, dY2) of the binary operation with
+  //the code eOp
+  inline void derivative(Op eOp, double dY1, double dY2, double & rD1, double & rD2)
+  {
+    switch (eOp) {
+    case eAdd: rD1 = 1.; rD2 = 1.; return;
+    case eSub: rD1 = 1.; rD2 = -1.; return;
+    case eMul: rD1 = dY2; rD2 = dY1; return;
+    case eDiv: rD1 = 1./dY2; rD2 = -dY1/(dY2*dY2); return;
+    case eMax: rD1 = (dY1 < dY2) ? 0. : 1.; rD2 = 1. - rD1; return;
+    case eMin: rD1 = (dY2 < dY1) ? 0. : 1.; rD2 = 1. - rD1; return;
+    default: ASSERT(false); rD1 = 0.; rD2 = 0.;
+    }
+  }
+
+  //the operations without codes are differentiated with the central
+  //difference
+  const double c_dStep = 1e-6;
+
+  inline double difference(const std::function<double(double)> & rOp, double dY)
+  {
+    double dH = c_dStep*std::max(1., std::abs(dY));
+    return (rOp(dY+dH) - rOp(dY-dH))/(2.*dH);
+  }
+
+  inline void difference(const std::function<double(double,double)> & rOp, 
+			 double dY1, double dY2, double & rD1, double & rD2)
+  {
+    double dH1 = c_dStep*std::max(1., std::abs(dY1));
+    double dH2 = c_dStep*std::max(1., std::abs(dY2));
+    rD1 = (rOp(dY1+dH1, dY2) - rOp(dY1-dH1, dY2))/(2.*dH1);
+    rD2 = (rOp(dY1, dY2+dH2) - rOp(dY1, dY2-dH2))/(2.*dH2);
+  }
+
+  //the size of scratch arrays for tangents kept on the stack
+  const unsigned c_iTangents = 64;
+
   // CLASS: Const
 	
   class Const: public IFunction
@@ -32,10 +114,23 @@ namespace cflFunction
     { 
       return m_dConst; 
     }	
+    void evaluate(const double * , double * pY, size_t iSize) const 
+    {
+      std::fill(pY, pY + iSize, m_dConst);
+    }
+    double tangent(double , double * pTangent, unsigned iTangents) const 
+    {
+      std::fill(pTangent, pTangent + iTangents, 0.);
+      return m_dConst;
+    }
     bool belongs(double  dX) const 
     { 
       return (dX>=m_dL) && (dX<=m_dR); 
     }
+
+    double value() const { return m_dConst; }
+    double left() const { return m_dL; }
+    double right() const { return m_dR; }
 		
   private:
     double m_dConst, m_dL, m_dR;
@@ -46,21 +141,45 @@ namespace cflFunction
   class Composite: public IFunction
   {
   public:
-    Composite(const Function & rFunc, const std::function<double(double)> & rUnOp) 
-      :m_uFunc(rFunc), m_uUnOp(rUnOp)
+    Composite(const Function & rFunc, const std::function<double(double)> & rUnOp, 
+	      Op eOp = eOpaque, double dArg = 0.) 
+      :m_uFunc(rFunc), m_uUnOp(rUnOp), m_eOp(eOp), m_dArg(dArg)
     {}
 
     double operator()(double dX) const 
     { 
       return m_uUnOp(m_uFunc(dX)); 
     }
+    void evaluate(const double * pX, double * pY, size_t iSize) const 
+    {
+      m_uFunc.evaluate(pX, pY, iSize);
+      for (size_t iI=0; iI<iSize; iI++) {
+	pY[iI] = m_uUnOp(pY[iI]);
+      }
+    }
+    double tangent(double dX, double * pTangent, unsigned iTangents) const 
+    {
+      double dY = m_uFunc.tangent(dX, pTangent, iTangents);
+      double dD = (m_eOp == eOpaque) ? difference(m_uUnOp, dY) 
+	: derivative(m_eOp, m_dArg, dY);
+      for (unsigned iI=0; iI<iTangents; iI++) {
+	pTangent[iI] *= dD;
+      }
+      return m_uUnOp(dY);
+    }
     bool belongs(double dX) const 
     { 
       return m_uFunc.belongs(dX); 
     }
+
+    const Function & func() const { return m_uFunc; }
+    Op op() const { return m_eOp; }
+    double arg() const { return m_dArg; }
   private:
     Function m_uFunc;
     std::function<double(double)> m_uUnOp;
+    Op m_eOp;
+    double m_dArg;
   };
 
   // CLASS: BinComposite
@@ -69,23 +188,56 @@ namespace cflFunction
   {
   public:
     BinComposite(const Function & rFunc1, const Function & rFunc2, 
-		 const std::function<double(double,double)> & rBinOp) 
-      :m_uFunc1(rFunc1), m_uFunc2(rFunc2), m_uBinOp(rBinOp)
+		 const std::function<double(double,double)> & rBinOp, 
+		 Op eOp = eOpaque) 
+      :m_uFunc1(rFunc1), m_uFunc2(rFunc2), m_uBinOp(rBinOp), m_eOp(eOp)
     {}
 
     double operator()(double dX) const 
     { 
       return m_uBinOp(m_uFunc1(dX), m_uFunc2(dX)); 
     }
+    void evaluate(const double * pX, double * pY, size_t iSize) const 
+    {
+      std::vector<double> uY2(iSize);
+      m_uFunc1.evaluate(pX, pY, iSize);
+      m_uFunc2.evaluate(pX, uY2.data(), iSize);
+      for (size_t iI=0; iI<iSize; iI++) {
+	pY[iI] = m_uBinOp(pY[iI], uY2[iI]);
+      }
+    }
+    double tangent(double dX, double * pTangent, unsigned iTangents) const 
+    {
+      Scratch<c_iTangents> uT2(iTangents);
+      double dY1 = m_uFunc1.tangent(dX, pTangent, iTangents);
+      double dY2 = m_uFunc2.tangent(dX, uT2.begin(), iTangents);
+      double dD1, dD2;
+      if (m_eOp == eOpaque) {
+	difference(m_uBinOp, dY1, dY2, dD1, dD2);
+      }
+      else {
+	derivative(m_eOp, dY1, dY2, dD1, dD2);
+      }
+      const double * pT2 = uT2.begin();
+      for (unsigned iI=0; iI<iTangents; iI++) {
+	pTangent[iI] = dD1*pTangent[iI] + dD2*pT2[iI];
+      }
+      return m_uBinOp(dY1, dY2);
+    }
     bool belongs(double dX) const 
     { 
       return (m_uFunc1.belongs(dX))&&(m_uFunc2.belongs(dX)); 
     }
+
+    const Function & func1() const { return m_uFunc1; }
+    const Function & func2() const { return m_uFunc2; }
+    Op op() const { return m_eOp; }
 		
   private:
     Function m_uFunc1;
     Function m_uFunc2;
     std::function<double(double,double)> m_uBinOp;
+    Op m_eOp;
   };
 }
 
@@ -103,53 +255,53 @@ Function & cfl::Function::operator=(double dV)
 
 Function & cfl::Function::operator+=(const Function & rFunc)
 {
-  m_pF.reset(new cflFunction::BinComposite(*this, rFunc, std::plus<double>())); 
+  m_pF.reset(new cflFunction::BinComposite(*this, rFunc, std::plus<double>(), cflFunction::eAdd)); 
   return *this;
 }
 
 Function & cfl::Function::operator*=(const Function & rFunc)
 {
-  m_pF.reset(new cflFunction::BinComposite(*this, rFunc, std::multiplies<double>()));
+  m_pF.reset(new cflFunction::BinComposite(*this, rFunc, std::multiplies<double>(), cflFunction::eMul));
   return *this;
 }
 
 Function & cfl::Function::operator-=(const Function & rFunc)
 {
-  m_pF.reset(new cflFunction::BinComposite(*this, rFunc, std::minus<double>()));
+  m_pF.reset(new cflFunction::BinComposite(*this, rFunc, std::minus<double>(), cflFunction::eSub));
   return *this;
 }
 
 Function & cfl::Function::operator/=(const Function & rFunc)
 {
-  m_pF.reset(new cflFunction::BinComposite(*this, rFunc, std::divides<double>()));
+  m_pF.reset(new cflFunction::BinComposite(*this, rFunc, std::divides<double>(), cflFunction::eDiv));
   return *this;
 }
 
 Function & cfl::Function::operator+=(double dX)
 {
   m_pF.reset(new cflFunction::Composite
-	     (*this, [dX](double dY) {return dY+dX;}));
+	     (*this, [dX](double dY) {return dY+dX;}, cflFunction::eAddC, dX));
   return *this;
 }
 
 Function & cfl::Function::operator-=(double dX)
 {
   m_pF.reset(new cflFunction::Composite
-	     (*this, [dX](double dY) {return dY-dX;}));
+	     (*this, [dX](double dY) {return dY-dX;}, cflFunction::eSubC, dX));
   return *this;
 }
 
 Function & cfl::Function::operator*=(double dX)
 {
   m_pF.reset(new cflFunction::Composite
-	     (*this, [dX](double dY) {return dY*dX;}));
+	     (*this, [dX](double dY) {return dY*dX;}, cflFunction::eMulC, dX));
   return *this;
 }
 
 Function & cfl::Function::operator/=(double dX)
 {
   m_pF.reset(new cflFunction::Composite
-	     (*this, [dX](double dY) {return dY/dX;}));
+	     (*this, [dX](double dY) {return dY/dX;}, cflFunction::eDivC, dX));
   return *this;
 }
 	
@@ -158,43 +310,43 @@ Function & cfl::Function::operator/=(double dX)
 Function cfl::operator-(const Function & rFunc)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, std::negate<double>()));
+		  (rFunc, std::negate<double>(), cflFunction::eNeg));
 }
 
 Function cfl::abs(const Function & rFunc)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, [](double dX){ return std::abs(dX); })); 
+		  (rFunc, [](double dX){ return std::abs(dX); }, cflFunction::eAbs)); 
 }
 
 Function cfl::exp(const Function & rFunc)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, [](double dX){ return std::exp(dX); })); 
+		  (rFunc, [](double dX){ return std::exp(dX); }, cflFunction::eExp)); 
 }
 
 Function cfl::log(const Function & rFunc)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, [](double dX){ return std::log(dX); })); 
+		  (rFunc, [](double dX){ return std::log(dX); }, cflFunction::eLog)); 
 }
 
 Function cfl::sqrt(const Function & rFunc)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, [](double dX){ return std::sqrt(dX); })); 
+		  (rFunc, [](double dX){ return std::sqrt(dX); }, cflFunction::eSqrt)); 
 }
 
 Function cfl::operator*(const Function & rFunc1, const Function & rFunc2)
 {
   return Function(new cflFunction::BinComposite
-		  (rFunc1, rFunc2, std::multiplies<double>()));
+		  (rFunc1, rFunc2, std::multiplies<double>(), cflFunction::eMul));
 }
 
 Function cfl::operator*(double dX, const Function & rFunc)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, [dX](double dY){return dX*dY;})); 
+		  (rFunc, [dX](double dY){return dX*dY;}, cflFunction::eMulC, dX)); 
 }
 
 Function cfl::operator*(const Function & rFunc, double dX)
@@ -205,13 +357,13 @@ Function cfl::operator*(const Function & rFunc, double dX)
 Function cfl::operator+(const Function & rFunc1, const Function & rFunc2)
 {
   return Function(new cflFunction::BinComposite
-		  (rFunc1, rFunc2, std::plus<double>()));
+		  (rFunc1, rFunc2, std::plus<double>(), cflFunction::eAdd));
 }
 
 Function cfl::operator+(double dX, const Function & rFunc)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, [dX](double dY){return dX+dY;}));
+		  (rFunc, [dX](double dY){return dX+dY;}, cflFunction::eAddC, dX));
 }
 
 Function cfl::operator+(const Function & rFunc,double dX)
@@ -222,49 +374,49 @@ Function cfl::operator+(const Function & rFunc,double dX)
 Function cfl::operator-(const Function & rFunc1, const Function & rFunc2)
 {
   return Function(new cflFunction::BinComposite
-		  (rFunc1, rFunc2, std::minus<double>()));
+		  (rFunc1, rFunc2, std::minus<double>(), cflFunction::eSub));
 }
 
 Function cfl::operator-(double dX, const Function & rFunc)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, [dX](double dY){return dX-dY;})); 
+		  (rFunc, [dX](double dY){return dX-dY;}, cflFunction::eCSub, dX)); 
 }
 
 Function cfl::operator-(const Function & rFunc, double dX)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, [dX](double dY){return dY-dX;})); 
+		  (rFunc, [dX](double dY){return dY-dX;}, cflFunction::eSubC, dX)); 
 }
 
 Function cfl::operator/(const Function & rFunc1, const Function & rFunc2)
 {
   return Function(new cflFunction::BinComposite
-		  (rFunc1, rFunc2, std::divides<double>()));
+		  (rFunc1, rFunc2, std::divides<double>(), cflFunction::eDiv));
 }
 
 Function cfl::operator/(double dX, const Function & rFunc)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, [dX](double dY){return dX/dY;})); 
+		  (rFunc, [dX](double dY){return dX/dY;}, cflFunction::eCDiv, dX)); 
 }
 
 Function cfl::operator/(const Function & rFunc, double dX)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, [dX](double dY){return dY/dX;})); 
+		  (rFunc, [dX](double dY){return dY/dX;}, cflFunction::eDivC, dX)); 
 }
 
 Function cfl::max(const Function & rFunc1, const Function & rFunc2)
 {
   return Function(new cflFunction::BinComposite
-		  (rFunc1, rFunc2, [](double dX, double dY){return std::max(dX,dY);})); 
+		  (rFunc1, rFunc2, [](double dX, double dY){return std::max(dX,dY);}, cflFunction::eMax)); 
 }
 
 Function cfl::max(double dX, const Function & rFunc)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, [dX](double dY){return std::max(dX,dY);})); 
+		  (rFunc, [dX](double dY){return std::max(dX,dY);}, cflFunction::eMaxC, dX)); 
 }
 
 Function cfl::max(const Function & rFunc, double dX)
@@ -275,13 +427,13 @@ Function cfl::max(const Function & rFunc, double dX)
 Function cfl::min(const Function & rFunc1, const Function & rFunc2)
 {
   return Function(new cflFunction::BinComposite
-		  (rFunc1, rFunc2, [](double dX, double dY){return std::min(dX,dY);})); 
+		  (rFunc1, rFunc2, [](double dX, double dY){return std::min(dX,dY);}, cflFunction::eMin)); 
 }
 
 Function cfl::min(double dX, const Function & rFunc)
 {
   return Function(new cflFunction::Composite
-		  (rFunc, [dX](double dY){return std::min(dX,dY);})); 
+		  (rFunc, [dX](double dY){return std::min(dX,dY);}, cflFunction::eMinC, dX)); 
 }
 
 Function cfl::min(const Function & rFunc, double dX)
@@ -291,7 +443,8 @@ Function cfl::min(const Function & rFunc, double dX)
 
 Function cfl::pow(const Function & rFunc, double dX)
 {
-  return Function(new cflFunction::Composite(rFunc, [dX](double dY){return std::pow(dY,dX);})); 
+  return Function(new cflFunction::Composite(rFunc, [dX](double dY){return std::pow(dY,dX);}, 
+					     cflFunction::ePowC, dX)); 
 }
 
 namespace cflFunction
@@ -316,17 +469,24 @@ namespace cflFunction
     double operator()(double dX) const 
     {
       PRECONDITION(belongs(dX));
-      std::valarray<double> uPoint(m_uPoint);
-      uPoint[m_iArg] = dX;
-      return m_uFunc(uPoint);
+      Scratch<c_iScratch> uPoint(m_uPoint.size());
+      point(dX, uPoint.begin());
+      return m_uFunc(uPoint.begin());
     }
     bool belongs(double dX) const 
     {
-      std::valarray<double> uPoint(m_uPoint);
-      uPoint[m_iArg] = dX;
-      return m_uFunc.belongs(uPoint);
+      Scratch<c_iScratch> uPoint(m_uPoint.size());
+      point(dX, uPoint.begin());
+      return m_uFunc.belongs(uPoint.begin());
     }
   private:
+    void point(double dX, double * pPoint) const
+    {
+      std::copy(cfl::begin(m_uPoint), cfl::end(m_uPoint), pPoint);
+      pPoint[m_iArg] = dX;
+    }
+
+    static const unsigned c_iScratch = 32;
     MultiFunction m_uFunc;
     unsigned m_iArg;
     std::valarray<double> m_uPoint;
@@ -337,3 +497,340 @@ Function cfl::toFunction(const cfl::MultiFunction & rFunc, unsigned iArg, const
 {
   return Function(new cflFunction::Adapter2(rFunc, iArg, rOtherArg));
 }
+
+namespace cflFunction
+{
+  //An instruction of the program of a compiled function. The
+  //arguments are taken from the top of the stack and the result is
+  //pushed back.
+  struct Instruction 
+  {
+    Op eOp;
+    double dArg;
+    unsigned iLeaf;
+  };
+
+  inline double unary(Op eOp, double dArg, double dY)
+  {
+    switch (eOp) {
+    case eNeg: return -dY;
+    case eAbs: return std::abs(dY);
+    case eExp: return std::exp(dY);
+    case eLog: return std::log(dY);
+    case eSqrt: return std::sqrt(dY);
+    case eAddC: return dY+dArg;
+    case eSubC: return dY-dArg;
+    case eCSub: return dArg-dY;
+    case eMulC: return dY*dArg;
+    case eDivC: return dY/dArg;
+    case eCDiv: return dArg/dY;
+    case eMaxC: return std::max(dArg,dY);
+    case eMinC: return std::min(dArg,dY);
+    case ePowC: return std::pow(dY,dArg);
+    default: ASSERT(false); return 0.;
+    }
+  }
+
+  inline double binary(Op eOp, double dY1, double dY2)
+  {
+    switch (eOp) {
+    case eAdd: return dY1+dY2;
+    case eSub: return dY1-dY2;
+    case eMul: return dY1*dY2;
+    case eDiv: return dY1/dY2;
+    case eMax: return std::max(dY1,dY2);
+    case eMin: return std::min(dY1,dY2);
+    default: ASSERT(false); return 0.;
+    }
+  }
+
+  inline bool isUnary(Op eOp) 
+  {
+    return (eOp >= eNeg) && (eOp <= ePowC);
+  }
+
+  // CLASS: Program
+
+  //Linear (postfix) form of a tree of Composite and BinComposite
+  //nodes. The leaves are the functions of other types; constant
+  //subtrees are folded.
+  class Program
+  {
+  public:
+    Program(const Function & rFunc)
+      :m_dL(-std::numeric_limits<double>::infinity()), 
+       m_dR(std::numeric_limits<double>::infinity()), m_iDepth(0)
+    {
+      unsigned iDepth = 0;
+      append(rFunc, iDepth);
+      ASSERT(iDepth == 1);
+    }
+
+    const std::vector<Instruction> & code() const { return m_uCode; }
+    const std::vector<Function> & leaves() const { return m_uLeaves; }
+    unsigned depth() const { return m_iDepth; }
+    double left() const { return m_dL; }
+    double right() const { return m_dR; }
+
+  private:
+    void push(const Instruction & rI, unsigned & rDepth)
+    {
+      m_uCode.push_back(rI);
+      rDepth++;
+      m_iDepth = std::max(m_iDepth, rDepth);
+    }
+
+    void append(const Function & rFunc, unsigned & rDepth);
+
+    std::vector<Instruction> m_uCode;
+    std::vector<Function> m_uLeaves;
+    double m_dL, m_dR;
+    unsigned m_iDepth;
+  };
+
+  // CLASS: Compiled
+
+  class Compiled: public IFunction
+  {
+  public:
+    Compiled(const Program & rProgram)
+      :m_uCode(rProgram.code()), m_uLeaves(rProgram.leaves()), 
+       m_iDepth(rProgram.depth()), m_dL(rProgram.left()), m_dR(rProgram.right())
+    {}
+
+    double operator()(double dX) const 
+    {
+      const unsigned c_iStack = 16;
+      if (m_iDepth <= c_iStack) {
+	double uStack[c_iStack];
+	return run(dX, uStack);
+      }
+      std::vector<double> uStack(m_iDepth);
+      return run(dX, uStack.data());
+    }
+
+    void evaluate(const double * pX, double * pY, size_t iSize) const 
+    {
+      //the stack holds the values at all points
+      std::vector<double> uStack(m_iDepth*iSize);
+      double * pTop = uStack.data();
+      for (const Instruction & rI : m_uCode) {
+	if (rI.eOp == eLeaf) {
+	  m_uLeaves[rI.iLeaf].evaluate(pX, pTop, iSize);
+	  pTop += iSize;
+	}
+	else if (rI.eOp == eConst) {
+	  std::fill(pTop, pTop + iSize, rI.dArg);
+	  pTop += iSize;
+	}
+	else if (isUnary(rI.eOp)) {
+	  double * pA = pTop - iSize;
+	  for (size_t iI=0; iI<iSize; iI++) {
+	    pA[iI] = unary(rI.eOp, rI.dArg, pA[iI]);
+	  }
+	}
+	else {
+	  pTop -= iSize;
+	  double * pA = pTop - iSize;
+	  for (size_t iI=0; iI<iSize; iI++) {
+	    pA[iI] = binary(rI.eOp, pA[iI], pTop[iI]);
+	  }
+	}
+      }
+      ASSERT(pTop == uStack.data() + iSize);
+      std::copy(uStack.begin(), uStack.begin() + iSize, pY);
+    }
+
+    double tangent(double dX, double * pTangent, unsigned iTangents) const 
+    {
+      //every value on the stack is followed by its tangents
+      unsigned iStep = iTangents + 1;
+      Scratch<c_iTangents> uStack(m_iDepth*iStep);
+      double * pTop = uStack.begin();
+      for (const Instruction & rI : m_uCode) {
+	if (rI.eOp == eLeaf) {
+	  *pTop = m_uLeaves[rI.iLeaf].tangent(dX, pTop + 1, iTangents);
+	  pTop += iStep;
+	}
+	else if (rI.eOp == eConst) {
+	  *pTop = rI.dArg;
+	  std::fill(pTop + 1, pTop + iStep, 0.);
+	  pTop += iStep;
+	}
+	else if (isUnary(rI.eOp)) {
+	  double * pA = pTop - iStep;
+	  double dD = derivative(rI.eOp, rI.dArg, pA[0]);
+	  pA[0] = unary(rI.eOp, rI.dArg, pA[0]);
+	  for (unsigned iI=1; iI<iStep; iI++) {
+	    pA[iI] *= dD;
+	  }
+	}
+	else {
+	  pTop -= iStep;
+	  double * pA = pTop - iStep;
+	  double dD1, dD2;
+	  derivative(rI.eOp, pA[0], pTop[0], dD1, dD2);
+	  pA[0] = binary(rI.eOp, pA[0], pTop[0]);
+	  for (unsigned iI=1; iI<iStep; iI++) {
+	    pA[iI] = dD1*pA[iI] + dD2*pTop[iI];
+	  }
+	}
+      }
+      ASSERT(pTop == uStack.begin() + iStep);
+      std::copy(uStack.begin() + 1, uStack.begin() + iStep, pTangent);
+      return uStack.begin()[0];
+    }
+
+    bool belongs(double dX) const 
+    {
+      if ((dX < m_dL) || (dX > m_dR)) {
+	return false;
+      }
+      for (const Function & rLeaf : m_uLeaves) {
+	if (!rLeaf.belongs(dX)) {
+	  return false;
+	}
+      }
+      return true;
+    }
+
+  private:
+    double run(double dX, double * pStack) const
+    {
+      double * pTop = pStack;
+      for (const Instruction & rI : m_uCode) {
+	if (rI.eOp == eLeaf) {
+	  *(pTop++) = m_uLeaves[rI.iLeaf](dX);
+	}
+	else if (rI.eOp == eConst) {
+	  *(pTop++) = rI.dArg;
+	}
+	else if (isUnary(rI.eOp)) {
+	  pTop[-1] = unary(rI.eOp, rI.dArg, pTop[-1]);
+	}
+	else {
+	  pTop--;
+	  pTop[-1] = binary(rI.eOp, pTop[-1], pTop[0]);
+	}
+      }
+      ASSERT(pTop == pStack + 1);
+      return *pStack;
+    }
+
+    std::vector<Instruction> m_uCode;
+    std::vector<Function> m_uLeaves;
+    unsigned m_iDepth;
+    double m_dL, m_dR;
+  };
+}
+
+namespace cflFunction
+{
+  // CLASS: Seed
+
+  //Function which depends linearly on the parameters 
+  //iFirst, ..., iFirst + rBasis.size() - 1.
+  class Seed: public IFunction
+  {
+  public:
+    Seed(const Function & rFunc, const std::vector<Function> & rBasis, unsigned iFirst)
+      :m_uFunc(rFunc), m_uBasis(rBasis), m_iFirst(iFirst)
+    {}
+
+    double operator()(double dX) const 
+    {
+      return m_uFunc(dX);
+    }
+    void evaluate(const double * pX, double * pY, size_t iSize) const 
+    {
+      m_uFunc.evaluate(pX, pY, iSize);
+    }
+    double tangent(double dX, double * pTangent, unsigned iTangents) const 
+    {
+      std::fill(pTangent, pTangent + iTangents, 0.);
+      unsigned iEnd = std::min<unsigned>(iTangents, m_iFirst + m_uBasis.size());
+      for (unsigned iI=m_iFirst; iI<iEnd; iI++) {
+	pTangent[iI] = m_uBasis[iI - m_iFirst](dX);
+      }
+      return m_uFunc(dX);
+    }
+    bool belongs(double dX) const 
+    {
+      return m_uFunc.belongs(dX);
+    }
+
+  private:
+    Function m_uFunc;
+    std::vector<Function> m_uBasis;
+    unsigned m_iFirst;
+  };
+}
+
+Function cfl::seed(const Function & rFunc, const std::vector<Function> & rBasis, 
+		   unsigned iFirst)
+{
+  return Function(new cflFunction::Seed(rFunc, rBasis, iFirst));
+}
+
+Function cfl::compile(const Function & rFunc)
+{
+  cflFunction::Program uProgram(rFunc);
+  const std::vector<cflFunction::Instruction> & rCode = uProgram.code();
+  if (rCode.size() == 1) {
+    if (rCode.front().eOp == cflFunction::eLeaf) {
+      return uProgram.leaves().front();
+    }
+    ASSERT(rCode.front().eOp == cflFunction::eConst);
+    return Function(rCode.front().dArg, uProgram.left(), uProgram.right());
+  }
+  return Function(new cflFunction::Compiled(uProgram));
+}
+
+void cflFunction::Program::append(const Function & rFunc, unsigned & rDepth)
+{
+  const IFunction * pF = rFunc.m_pF.get();
+  const Const * pConst = dynamic_cast<const Const *>(pF);
+  if (pConst) {
+    m_dL = std::max(m_dL, pConst->left());
+    m_dR = std::min(m_dR, pConst->right());
+    Instruction uI = { eConst, pConst->value(), 0 };
+    push(uI, rDepth);
+    return;
+  }
+  const Composite * pComposite = dynamic_cast<const Composite *>(pF);
+  if (pComposite && (pComposite->op() != eOpaque)) {
+    append(pComposite->func(), rDepth);
+    Instruction & rLast = m_uCode.back();
+    if (rLast.eOp == eConst) {
+      rLast.dArg = unary(pComposite->op(), pComposite->arg(), rLast.dArg);
+    }
+    else {
+      Instruction uI = { pComposite->op(), pComposite->arg(), 0 };
+      m_uCode.push_back(uI);
+    }
+    return;
+  }
+  const BinComposite * pBin = dynamic_cast<const BinComposite *>(pF);
+  if (pBin && (pBin->op() != eOpaque)) {
+    unsigned iStart = m_uCode.size();
+    append(pBin->func1(), rDepth);
+    unsigned iMiddle = m_uCode.size();
+    append(pBin->func2(), rDepth);
+    if ((iMiddle == iStart + 1) && (m_uCode.size() == iMiddle + 1) && 
+	(m_uCode[iStart].eOp == eConst) && (m_uCode[iMiddle].eOp == eConst)) {
+      m_uCode[iStart].dArg = binary(pBin->op(), m_uCode[iStart].dArg, 
+				    m_uCode[iMiddle].dArg);
+      m_uCode.pop_back();
+    }
+    else {
+      Instruction uI = { pBin->op(), 0., 0 };
+      m_uCode.push_back(uI);
+    }
+    rDepth--;
+    return;
+  }
+  //the leaf of the program
+  Instruction uI = { eLeaf, 0., static_cast<unsigned>(m_uLeaves.size()) };
+  m_uLeaves.push_back(rFunc);
+  push(uI, rDepth);
+}
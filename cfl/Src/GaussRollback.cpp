@@ -13,6 +13,23 @@
 
 using namespace cfl;
 
+// CLASS: IGaussRollback
+
+void cfl::IGaussRollback::rollback(std::valarray<double> & rValues, 
+				   unsigned iColumns) const
+{
+    PRECONDITION((iColumns > 0) && (rValues.size() % iColumns == 0));
+    unsigned iSize = rValues.size()/iColumns;
+    for (unsigned iJ=0; iJ<iColumns; iJ++) {
+	std::slice uColumn(iJ, iSize, iColumns);
+	std::valarray<double> uValues(rValues[uColumn]);
+	rollback(uValues);
+	rValues[uColumn] = uValues;
+    }
+}
+
+// CLASS: GaussRollback
+
 cfl::GaussRollback::GaussRollback(IGaussRollback * pNewP)
     :m_uP(pNewP)
 {}
@@ -39,6 +56,29 @@ namespace cflGaussRollback
 	rV[rV.size()-1] = dR;
     }
 
+    //the same step for the columns of the matrix rV stored row by row;
+    //rPrev is the scratch space of the size iColumns 
+    void oneStep(std::valarray<double> & rV, const double & dB, 
+		 unsigned iColumns, std::valarray<double> & rPrev) 
+    {
+	ASSERT(rPrev.size() == iColumns);
+	unsigned iRows = rV.size()/iColumns;
+	double dC = 1.-2.*dB;
+	double * pPrev = &rPrev[0];
+	double * pRow = &rV[0];
+	std::copy(pRow, pRow + iColumns, pPrev);
+	//the first and the last rows are the boundary conditions
+	for (unsigned iI=1; iI+1<iRows; iI++) {
+	    pRow += iColumns;
+	    const double * pNext = pRow + iColumns;
+	    for (unsigned iJ=0; iJ<iColumns; iJ++) {
+		double dV = pRow[iJ];
+		pRow[iJ] = dC*dV + dB*(pPrev[iJ] + pNext[iJ]);
+		pPrev[iJ] = dV;
+	    }
+	}
+    }
+
 
     // CLASS: Explicit
 	
@@ -86,6 +126,15 @@ namespace cflGaussRollback
 		    cflGaussRollback::oneStep(rVec, m_dB);
 		}
 	    }
+
+	void rollback(std::valarray<double> & rVec, unsigned iColumns) const
+	    {
+		PRECONDITION(rVec.size() == m_iSize*iColumns);
+		std::valarray<double> uPrev(iColumns);
+		for (unsigned int iI=0; iI<m_iSteps; iI++) {
+		    cflGaussRollback::oneStep(rVec, m_dB, iColumns, uPrev);
+		}
+	    }
 		
     private:
 	unsigned int m_iSize, m_iSteps;
@@ -150,6 +199,28 @@ namespace cflGaussRollback
 		    throw(NError::range("theta"));
 		}
 	    }
+
+	void rollback(std::valarray<double> & rV, unsigned iColumns) const
+	    {
+		PRECONDITION(rV.size() == m_iSize*iColumns);
+			
+		if (m_dTheta > 0) {
+		    std::valarray<double> uPrev(iColumns);
+		    for (unsigned int iI=0; iI<m_iSteps; iI++) {
+			cflGaussRollback::oneStep(rV, m_dB, iColumns, uPrev);
+			m_uTridiag.solve(rV, iColumns);
+		    }
+		}
+		else if (m_dTheta == 0) { //pure implicit
+		    for (unsigned int iI=0; iI<m_iSteps; iI++) {
+			m_uTridiag.solve(rV, iColumns);
+		    }
+		}
+		else {
+		    ASSERT(false);
+		    throw(NError::range("theta"));
+		}
+	    }
 		
     private:
 	unsigned m_iSize, m_iSteps;
@@ -209,6 +280,15 @@ namespace cflGaussRollback
 		    m_uImplicit.rollback(rV);
 		}			
 	    }
+
+	void rollback(std::valarray<double> & rV, unsigned iColumns) const 
+	    {
+		m_uUniform.rollback(rV, iColumns);
+		if (m_bOnlyUniform==false) {
+		    m_uFast.rollback(rV, iColumns);
+		    m_uImplicit.rollback(rV, iColumns);
+		}			
+	    }
     private:
 	GaussRollback m_uFast, m_uUniform, m_uImplicit;
 	bool m_bOnlyUniform;
@@ -0,0 +1,253 @@
+// Implementation of classes and functions declared in the corresponding *.hpp file.
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "cfl/HullWhiteAnalytic.hpp"
+#include "cfl/Error.hpp"
+
+using namespace cfl;
+using namespace cfl::HullWhite;
+
+namespace cflHullWhite
+{
+  const double c_dSqrt1_2 = 0.70710678118654752440;
+
+  //option on zero-coupon bond; the payoff at dExpiry equals
+  //dWeight*max(P(dExpiry, dMaturity) - dStrike, 0) for calls and
+  //dWeight*max(dStrike - P(dExpiry, dMaturity), 0) for puts
+  struct BondOption
+  {
+    unsigned iTrade;
+    double dWeight, dStrike, dExpiry, dMaturity;
+    bool bCall;
+  };
+
+  //adds the prices of the options to pPrice[iTrade*iSize + iJ]
+  void price(const HullWhite::Data & rData, const std::vector<BondOption> & rOptions,
+	     const double * pX, double * pPrice, size_t iSize)
+  {
+    //the expiries are followed by the maturities
+    unsigned iOptions = rOptions.size();
+    double dInitialTime = rData.initialTime();
+    std::vector<double> uTime(2*iOptions), uDiscount(2*iOptions),
+      uShape(2*iOptions), uVol(iOptions);
+    for (unsigned iI=0; iI<iOptions; iI++) {
+      PRECONDITION(rOptions[iI].dExpiry >= dInitialTime);
+      PRECONDITION(rOptions[iI].dMaturity >= rOptions[iI].dExpiry);
+      uTime[iI] = rOptions[iI].dExpiry;
+      uTime[iOptions + iI] = rOptions[iI].dMaturity;
+    }
+    rData.discount().evaluate(uTime.data(), uDiscount.data(), uTime.size());
+    rData.shape().evaluate(uTime.data(), uShape.data(), uTime.size());
+    rData.volatility().evaluate(uTime.data(), uVol.data(), iOptions);
+    double dA0 = rData.shape()(dInitialTime);
+    double dD0 = rData.discount()(dInitialTime);
+
+    //the value of P(expiry, maturity) for the state y at expiry equals
+    //D(maturity)/D(expiry)*exp((B - A)*y - 0.5*(B - A)^2*V), where A
+    //and B are the values of the shape at expiry and maturity and V
+    //is the variance of the state
+    std::vector<double> uN1(iSize), uN2(iSize);
+    const double c_dInf = std::numeric_limits<double>::infinity();
+    for (unsigned iI=0; iI<iOptions; iI++) {
+      const BondOption & rOption = rOptions[iI];
+      double dA = uShape[iI];
+      double dB = uShape[iOptions + iI];
+      double dStd = std::abs(dB - dA)*uVol[iI]*std::sqrt(rOption.dExpiry - dInitialTime);
+      double dLogF = std::log(uDiscount[iOptions + iI]/(uDiscount[iI]*rOption.dStrike));
+      double dSign = (rOption.bCall) ? 1. : -1.;
+      if (dStd > 0.) {
+	double dInvStd = 1./dStd;
+	for (size_t iJ=0; iJ<iSize; iJ++) {
+	  double dD1 = (dLogF + (dB - dA)*pX[iJ])*dInvStd + 0.5*dStd;
+	  uN1[iJ] = dSign*dD1;
+	  uN2[iJ] = dSign*(dD1 - dStd);
+	}
+      }
+      else {
+	for (size_t iJ=0; iJ<iSize; iJ++) {
+	  double dM = dLogF + (dB - dA)*pX[iJ];
+	  uN1[iJ] = (dM > 0.) ? dSign*c_dInf : -dSign*c_dInf;
+	  uN2[iJ] = uN1[iJ];
+	}
+      }
+      for (size_t iJ=0; iJ<iSize; iJ++) {
+	uN1[iJ] = 0.5*std::erfc(-uN1[iJ]*c_dSqrt1_2);
+	uN2[iJ] = 0.5*std::erfc(-uN2[iJ]*c_dSqrt1_2);
+      }
+      //the values at the initial state of the zero-coupon bonds
+      //with the maturities and the expiries
+      double dBond = dSign*rOption.dWeight*uDiscount[iOptions + iI]/dD0;
+      double dCash = dSign*rOption.dWeight*rOption.dStrike*uDiscount[iI]/dD0;
+      double * pP = pPrice + rOption.iTrade*iSize;
+      for (size_t iJ=0; iJ<iSize; iJ++) {
+	pP[iJ] += dBond*std::exp((dB - dA0)*pX[iJ])*uN1[iJ]
+	  - dCash*std::exp((dA - dA0)*pX[iJ])*uN2[iJ];
+      }
+    }
+  }
+
+  //caplets are puts and floorlets are calls on zero-coupon bonds
+  void cap(const cfl::Data::CashFlow & rCap, unsigned iTrade, double dInitialTime,
+	   bool bFloor, std::vector<BondOption> & rOptions)
+  {
+    double dCapFactor = 1. + rCap.rate*rCap.period;
+    double dExpiry = dInitialTime;
+    for (unsigned iI=0; iI<rCap.numberOfPayments; iI++) {
+      BondOption uOption = { iTrade, rCap.notional*dCapFactor, 1./dCapFactor,
+			     dExpiry, dExpiry + rCap.period, bFloor };
+      rOptions.push_back(uOption);
+      dExpiry += rCap.period;
+    }
+  }
+
+  //Jamshidian decomposition of the option on coupon bond
+  void swaption(const HullWhite::Data & rData, const cfl::Data::Swap & rSwap,
+		double dMaturity, unsigned iTrade, std::vector<BondOption> & rOptions)
+  {
+    PRECONDITION(dMaturity >= rData.initialTime());
+    const unsigned c_iMaxIter = 100;
+    cfl::Data::Schedule uBond(rSwap, dMaturity);
+    const std::vector<double> & rTime = uBond.paymentTimes();
+    const std::vector<double> & rPayment = uBond.payments();
+    std::vector<double> uB(rTime.size()), uD(rTime.size());
+    rData.shape().evaluate(rTime.data(), uB.data(), uB.size());
+    rData.discount().evaluate(rTime.data(), uD.data(), uD.size());
+    double dA = rData.shape()(dMaturity);
+    double dDA = rData.discount()(dMaturity);
+    double dVar = std::pow(rData.volatility()(dMaturity), 2)*
+      (dMaturity - rData.initialTime());
+    for (unsigned iI=0; iI<uB.size(); iI++) {
+      uB[iI] -= dA;
+      uD[iI] /= dDA;
+    }
+    //Newton method for the state y where the coupon bond equals the notional
+    std::vector<double> uStrike(rTime.size());
+    double dY = 0.;
+    double dErr = 0.;
+    unsigned iIter = 0;
+    do {
+      double dValue = -rSwap.notional;
+      double dSlope = 0.;
+      for (unsigned iI=0; iI<uStrike.size(); iI++) {
+	uStrike[iI] = uD[iI]*std::exp(uB[iI]*dY - 0.5*uB[iI]*uB[iI]*dVar);
+	dValue += rPayment[iI]*uStrike[iI];
+	dSlope += rPayment[iI]*uB[iI]*uStrike[iI];
+      }
+      dErr = std::abs(dValue);
+      if (dSlope == 0.) {
+	//bond prices do not depend on the state
+	double dScale = rSwap.notional/(rSwap.notional + dValue);
+	std::transform(uStrike.begin(), uStrike.end(), uStrike.begin(),
+		       [dScale](double dK) { return dK*dScale; });
+	dErr = 0.;
+      }
+      else {
+	dY -= dValue/dSlope;
+      }
+      iIter++;
+    } while ((dErr > 1e-14*rSwap.notional) && (iIter < c_iMaxIter));
+    if (!(dErr <= 1e-14*rSwap.notional)) {
+      throw(NError::range("Jamshidian decomposition of swaption"));
+    }
+    //receiver swaption (payFloat = true) is a call on coupon bond
+    for (unsigned iI=0; iI<rTime.size(); iI++) {
+      BondOption uOption = { iTrade, rPayment[iI], uStrike[iI], dMaturity,
+			     rTime[iI], rSwap.payFloat };
+      rOptions.push_back(uOption);
+    }
+  }
+
+  //closed-form price of one trade as function of the state process
+  class Formula: public IFunction
+  {
+  public:
+    Formula(const HullWhite::Data & rData, const std::vector<BondOption> & rOptions)
+      :m_uData(rData), m_uOptions(rOptions)
+    {}
+
+    double operator()(double dX) const
+    {
+      double dPrice = 0.;
+      cflHullWhite::price(m_uData, m_uOptions, &dX, &dPrice, 1);
+      return dPrice;
+    }
+
+    void evaluate(const double * pX, double * pY, size_t iSize) const
+    {
+      std::fill(pY, pY + iSize, 0.);
+      cflHullWhite::price(m_uData, m_uOptions, pX, pY, iSize);
+    }
+
+    bool belongs(double) const
+    {
+      return true;
+    }
+
+  private:
+    HullWhite::Data m_uData;
+    std::vector<BondOption> m_uOptions;
+  };
+}
+
+void cfl::HullWhite::cap(const Data & rData, const std::vector<cfl::Data::CashFlow> & rCaps,
+			 bool bFloor, const double * pX, double * pPrice, size_t iSize)
+{
+  std::vector<cflHullWhite::BondOption> uOptions;
+  for (unsigned iI=0; iI<rCaps.size(); iI++) {
+    cflHullWhite::cap(rCaps[iI], iI, rData.initialTime(), bFloor, uOptions);
+  }
+  std::fill(pPrice, pPrice + rCaps.size()*iSize, 0.);
+  cflHullWhite::price(rData, uOptions, pX, pPrice, iSize);
+}
+
+MultiFunction cfl::HullWhite::cap(const Data & rData, const cfl::Data::CashFlow & rCap)
+{
+  std::vector<cflHullWhite::BondOption> uOptions;
+  cflHullWhite::cap(rCap, 0, rData.initialTime(), false, uOptions);
+  return toMultiFunction(Function(new cflHullWhite::Formula(rData, uOptions)), 0, 1);
+}
+
+MultiFunction cfl::HullWhite::floor(const Data & rData, const cfl::Data::CashFlow & rFloor)
+{
+  std::vector<cflHullWhite::BondOption> uOptions;
+  cflHullWhite::cap(rFloor, 0, rData.initialTime(), true, uOptions);
+  return toMultiFunction(Function(new cflHullWhite::Formula(rData, uOptions)), 0, 1);
+}
+
+void cfl::HullWhite::swaption(const Data & rData, const std::vector<cfl::Data::Swap> & rSwaps,
+			      const std::vector<double> & rMaturities,
+			      const double * pX, double * pPrice, size_t iSize)
+{
+  PRECONDITION(rSwaps.size() == rMaturities.size());
+  std::vector<cflHullWhite::BondOption> uOptions;
+  for (unsigned iI=0; iI<rSwaps.size(); iI++) {
+    cflHullWhite::swaption(rData, rSwaps[iI], rMaturities[iI], iI, uOptions);
+  }
+  std::fill(pPrice, pPrice + rSwaps.size()*iSize, 0.);
+  cflHullWhite::price(rData, uOptions, pX, pPrice, iSize);
+}
+
+MultiFunction cfl::HullWhite::swaption(const Data & rData, const cfl::Data::Swap & rSwap,
+				       double dMaturity)
+{
+  std::vector<cflHullWhite::BondOption> uOptions;
+  cflHullWhite::swaption(rData, rSwap, dMaturity, 0, uOptions);
+  return toMultiFunction(Function(new cflHullWhite::Formula(rData, uOptions)), 0, 1);
+}
+
+double cfl::HullWhite::validate(const MultiFunction & rExact, const MultiFunction & rNumeric,
+				double dInterval, unsigned iPoints)
+{
+  PRECONDITION((rExact.dim() == 1) && (rNumeric.dim() == 1) && (iPoints > 0));
+  PRECONDITION(dInterval >= 0.);
+  double dError = 0.;
+  std::valarray<double> uX(1);
+  double dStep = (iPoints > 1) ? dInterval/(iPoints - 1.) : 0.;
+  for (unsigned iI=0; iI<iPoints; iI++) {
+    uX[0] = (iPoints > 1) ? -0.5*dInterval + iI*dStep : 0.;
+    dError = std::max(dError, std::abs(rExact(uX) - rNumeric(uX)));
+  }
+  return dError;
+}
@@ -9,13 +9,13 @@ cfl::HullWhite::Data::Data(const cfl::Function & rDiscount,
 			   const Function & rShape, 
 			   double dInitialTime
 			   )
-  :m_uDiscount(rDiscount), m_uVolatility(rVolatility), 
-   m_uShape(rShape), m_dInitialTime(dInitialTime)
+  :m_uDiscount(compile(rDiscount)), m_uVolatility(compile(rVolatility)), 
+   m_uShape(compile(rShape)), m_dInitialTime(dInitialTime)
 {}
 
 cfl::HullWhite::Data::Data(const cfl::Function & rDiscount, double dSigma, 
 			   double dLambda, double dInitialTime)
-  :m_uDiscount(rDiscount), 
+  :m_uDiscount(compile(rDiscount)), 
    m_uVolatility(cfl::Data::volatility(dSigma, dLambda, dInitialTime)),
    m_uShape(cfl::Data::bondShape(dLambda, dInitialTime)),
    m_dInitialTime(dInitialTime)
@@ -2,6 +2,7 @@
 // Implementation of classes and functions declared in the corresponding *.hpp file. 
 
 #include <limits>
+#include <cmath>
 #include "cfl/HullWhiteModel.hpp"
 #include "cfl/Error.hpp"
 
@@ -20,6 +21,9 @@ namespace cflHullWhite
 
     Slice discount(unsigned iTime, double dBondMaturity) const; 
 
+    Slice discount(unsigned iTime, const std::vector<double> & rMaturities, 
+		   const std::vector<double> & rAmounts) const; 
+
     const std::vector<double> & eventTimes() const;
  
     unsigned numberOfStates() const;
@@ -34,8 +38,14 @@ namespace cflHullWhite
 		       const std::vector<unsigned> & rStates) const;
 
     void rollback(Slice & rSlice, unsigned iEventTime) const;
+    void rollback(std::vector<Slice> & rSlices, unsigned iEventTime) const;
+    void rollback(Slice & rSlice, unsigned iEventTime, 
+		  const Slice & rStart, const Slice & rEnd, 
+		  double dLowerBarrier, double dUpperBarrier) const;
 
     void indicator(Slice & rSlice, double dBarrier) const;
+    std::vector<Slice> indicator(const Slice & rSlice, 
+				 const std::vector<double> & rBarriers) const;
 
     MultiFunction interpolate(const Slice & rSlice) const;
 
@@ -43,6 +53,11 @@ namespace cflHullWhite
     HullWhite::Data m_uData; 
     double m_dInterval;
     Brownian m_uBrownian; 
+    //discount factors for the event times
+    std::vector<double> m_uDiscount;
+    //the discount factors with the maturity eventTimes().back() 
+    //(the numeraire) and their inverses at the event times
+    std::vector<Slice> m_uNumeraire, m_uInverseNumeraire;
   };
 }
 
@@ -61,12 +76,21 @@ InterestRateModel cfl::HullWhite::model(const HullWhite::Data & rData,
 
 cflHullWhite::Model::Model(const HullWhite::Data & rData, const std::vector<double> & rEventTimes, 
 			   double dInterval, const Brownian & rBrownian)
-  :m_uData(rData), m_dInterval(dInterval), m_uBrownian(rBrownian)
+  :m_uData(rData), m_dInterval(dInterval), m_uBrownian(rBrownian), 
+   m_uDiscount(rEventTimes.size())
 {
+  rData.discount().evaluate(rEventTimes.data(), m_uDiscount.data(), 
+			    m_uDiscount.size());
   std::vector<double> uVar(rEventTimes.size());
-  std::transform(rEventTimes.begin(), rEventTimes.end(), uVar.begin(), 
-		 cfl::pow(rData.volatility(), 2));
+  cfl::pow(rData.volatility(), 2).evaluate(rEventTimes.data(), uVar.data(), 
+					  uVar.size());
   m_uBrownian.assign(uVar, rEventTimes, dInterval);
+  m_uNumeraire.reserve(rEventTimes.size());
+  m_uInverseNumeraire.reserve(rEventTimes.size());
+  for (unsigned iTime=0; iTime<rEventTimes.size(); iTime++) {
+    m_uNumeraire.push_back(discount(iTime, rEventTimes.back()));
+    m_uInverseNumeraire.push_back(1./m_uNumeraire.back());
+  }
 }
 
 IInterestRateModel * cflHullWhite::Model::newModel(const std::vector<double> & rEventTimes) const 
@@ -82,19 +106,57 @@ Slice cflHullWhite::Model::discount(unsigned iTime, double dBondMaturity) const
   if (dBondMaturity==dRefTime) {
     return Slice(this, iTime, 1.);
   }
+  if ((dBondMaturity == eventTimes().back()) && (iTime < m_uNumeraire.size())) {
+    return m_uNumeraire[iTime];
+  }
  
   double dA = m_uData.shape()(dRefTime);
   double dB = m_uData.shape()(dBondMaturity);
   double dC = m_uData.shape()(eventTimes().back());
   double dVar = ::pow(m_uData.volatility()(dRefTime),2)*
     (dRefTime-m_uData.initialTime());
-  double dForwardDiscount = 
-    m_uData.discount()(dBondMaturity)/m_uData.discount()(dRefTime);
+  double dBondDiscount = (dBondMaturity == eventTimes().back()) ? 
+    m_uDiscount.back() : m_uData.discount()(dBondMaturity);
+  double dForwardDiscount = dBondDiscount/m_uDiscount[iTime];
   Slice uDiscount = exp(state(iTime,0)*(dB-dA));
   uDiscount*=(dForwardDiscount*std::exp(- 0.5*(dB-dA)*(dA+dB-2.*dC)*dVar));
   return uDiscount; 
 } 
 
+Slice cflHullWhite::Model::discount(unsigned iTime, 
+				    const std::vector<double> & rMaturities, 
+				    const std::vector<double> & rAmounts) const 
+{
+  PRECONDITION(iTime < eventTimes().size());
+  PRECONDITION(rMaturities.size() == rAmounts.size());
+  double dRefTime = eventTimes()[iTime];	
+  double dA = m_uData.shape()(dRefTime);
+  double dC = m_uData.shape()(eventTimes().back());
+  double dVar = ::pow(m_uData.volatility()(dRefTime),2)*
+    (dRefTime-m_uData.initialTime());
+  //the value of the payment iI equals uFactor[iI]*exp(state*uExponent[iI])
+  std::vector<double> uExponent(rMaturities.size()), uFactor(rMaturities.size());
+  m_uData.shape().evaluate(rMaturities.data(), uExponent.data(), uExponent.size());
+  m_uData.discount().evaluate(rMaturities.data(), uFactor.data(), uFactor.size());
+  for (unsigned iI=0; iI<rMaturities.size(); iI++) {
+    PRECONDITION(rMaturities[iI] >= dRefTime);
+    double dB = uExponent[iI];
+    uExponent[iI] = dB - dA;
+    uFactor[iI] *= rAmounts[iI]/m_uDiscount[iTime]*
+      std::exp(- 0.5*(dB-dA)*(dA+dB-2.*dC)*dVar);
+  }
+  Slice uValue = state(iTime,0);
+  const std::valarray<double> & rState = uValue.values();
+  std::valarray<double> uSum(0., rState.size());
+  for (unsigned iI=0; iI<rMaturities.size(); iI++) {
+    for (unsigned iJ=0; iJ<rState.size(); iJ++) {
+      uSum[iJ] += uFactor[iI]*std::exp(rState[iJ]*uExponent[iI]);
+    }
+  }
+  uValue.assign(uSum);
+  return uValue;
+} 
+
 const std::vector<double> & cflHullWhite::Model::eventTimes() const
 {
   return m_uBrownian.eventTimes();
@@ -133,11 +195,39 @@ void cflHullWhite::Model::addDependence(Slice & rSlice,
 
 void cflHullWhite::Model::rollback(Slice & rSlice, unsigned iEventTime) const 
 {
-  rSlice /= discount(rSlice.timeIndex(), eventTimes().back());
+  rSlice *= m_uInverseNumeraire[rSlice.timeIndex()];
   rSlice.assign(m_uBrownian);
   rSlice.rollback(iEventTime);
   rSlice.assign(*this);
-  rSlice *= discount(iEventTime, eventTimes().back());
+  rSlice *= m_uNumeraire[iEventTime];
+}
+
+void cflHullWhite::Model::rollback(std::vector<Slice> & rSlices, unsigned iEventTime) const 
+{
+  for (unsigned iI=0; iI<rSlices.size(); iI++) {
+    rSlices[iI] *= m_uInverseNumeraire[rSlices[iI].timeIndex()];
+    rSlices[iI].assign(m_uBrownian);
+  }
+  m_uBrownian.rollback(rSlices, iEventTime);
+  for (unsigned iI=0; iI<rSlices.size(); iI++) {
+    rSlices[iI].assign(*this);
+    rSlices[iI] *= m_uNumeraire[iEventTime];
+  }
+}
+
+void cflHullWhite::Model::rollback(Slice & rSlice, unsigned iEventTime, 
+				   const Slice & rStart, const Slice & rEnd, 
+				   double dLowerBarrier, double dUpperBarrier) const 
+{
+  rSlice *= m_uInverseNumeraire[rSlice.timeIndex()];
+  Slice uStart(rStart);
+  uStart.assign(m_uBrownian);
+  Slice uEnd(rEnd);
+  uEnd.assign(m_uBrownian);
+  rSlice.assign(m_uBrownian);
+  m_uBrownian.rollback(rSlice, iEventTime, uStart, uEnd, dLowerBarrier, dUpperBarrier);
+  rSlice.assign(*this);
+  rSlice *= m_uNumeraire[iEventTime];
 }
 
 void cflHullWhite::Model::indicator(Slice & rSlice, double dBarrier) const
@@ -147,6 +237,18 @@ void cflHullWhite::Model::indicator(Slice & rSlice, double dBarrier) const
   rSlice.assign(*this);
 }
 
+std::vector<Slice> 
+cflHullWhite::Model::indicator(const Slice & rSlice, const std::vector<double> & rBarriers) const
+{
+  Slice uSlice(rSlice);
+  uSlice.assign(m_uBrownian);
+  std::vector<Slice> uInd = m_uBrownian.indicator(uSlice, rBarriers);
+  for (unsigned iK=0; iK<uInd.size(); iK++) {
+    uInd[iK].assign(*this);
+  }
+  return uInd;
+}
+
 MultiFunction cflHullWhite::Model::interpolate(const Slice & rSlice) const
 {
   Slice uSlice(rSlice);
@@ -16,36 +16,47 @@ cfl::Ind::Ind(IInd * pNewInd)
   :m_pInd(pNewInd) 
 {}
 
+void cfl::IInd::indicator(const std::valarray<double> & rValues, 
+			  const std::vector<double> & rBarriers, 
+			  std::valarray<double> & rInd) const
+{
+  unsigned iSize = rValues.size();
+  rInd.resize(iSize*rBarriers.size());
+  std::valarray<double> uValues(iSize);
+  for (unsigned iK=0; iK<rBarriers.size(); iK++) {
+    uValues = rValues;
+    indicator(uValues, rBarriers[iK]);
+    rInd[std::slice(iK*iSize, iSize, 1)] = uValues;
+  }
+}
+
 namespace cflInd 
 {
-  class SmartInd: public std::function<double(double, double)> 
+  //The part of the smoothed indicator of the event "v > 0" that comes
+  //from the interval between two nodes and goes to the left node;
+  //dL and dR are the values at the nodes. The selects have no
+  //branches, so the loops below vectorize.
+  inline double leftPart(double dL, double dR)
   {
-  public:
-    SmartInd(double & rHistInd)
-      :m_rHistInd(rHistInd)
-    {}
-    double operator()(double dValLeft, double dValRight) 
-    {
-      double dResult = m_rHistInd;
-      bool bBelow = (dValLeft <= 0.);
-      //assume first that dValLeft <= 0
-      if ((bBelow && (dValRight > 0.)) || (!bBelow && (dValRight < 0.))) {
-	m_rHistInd = 0.5*dValRight/(dValRight - dValLeft);
-	ASSERT((m_rHistInd >0.)&&(m_rHistInd <= 0.5));
-      }
-      else {
-	m_rHistInd = 0.;
-      }
-      //now account for the possibility that dValLeft > 0
-      if (!bBelow) {
-	m_rHistInd = 0.5 - m_rHistInd;
-      }
-      dResult += m_rHistInd;
-      return dResult;
+    bool bBelow = (dL <= 0.);
+    bool bCross = bBelow ? (dR > 0.) : (dR < 0.);
+    double dDist = bCross ? (dR - dL) : 1.;
+    double dPart = bCross ? 0.5*dR/dDist : 0.;
+    return bBelow ? dPart : 0.5 - dPart;
+  }
+
+  //The indicator at a node is the sum of the parts that come from the
+  //intervals on its left and its right. The first pass stores the
+  //parts of the intervals in pInd[0], ..., pInd[iSize-2], the second
+  //pass adds the neighbours.
+  inline void addParts(double * pInd, unsigned iSize, double dFirst, double dLast)
+  {
+    pInd[iSize-1] = dLast;
+    for (unsigned iI=iSize-1; iI>0; iI--) {
+      pInd[iI] += pInd[iI-1];
     }
-  private:
-    double & m_rHistInd;
-  };
+    pInd[0] += dFirst;
+  }
 
   class  Smart: public IInd
   {
@@ -53,16 +64,40 @@ namespace cflInd
     void indicator(std::valarray<double> & rValues, 
 		   double dBarrier) const 
     {
-      rValues -= dBarrier;
-      double dIndLeft = (rValues[0] <=0) ? 0. : 0.5;
-      std::transform(begin(rValues), end(rValues)-1, begin(rValues)+1, 
-		     &rValues[0], SmartInd(dIndLeft));
-      //finish at right end
-      if (rValues[rValues.size()-1] <=0 ) {
-	rValues[rValues.size()-1] = dIndLeft;
+      unsigned iSize = rValues.size();
+      PRECONDITION(iSize > 0);
+      double * pV = &rValues[0];
+      double dFirst = (pV[0] - dBarrier <= 0.) ? 0. : 0.5;
+      double dLast = (pV[iSize-1] - dBarrier <= 0.) ? 0. : 0.5;
+      for (unsigned iI=0; iI+1<iSize; iI++) {
+	pV[iI] = leftPart(pV[iI] - dBarrier, pV[iI+1] - dBarrier);
+      }
+      addParts(pV, iSize, dFirst, dLast);
+    }
+
+    void indicator(const std::valarray<double> & rValues, 
+		   const std::vector<double> & rBarriers, 
+		   std::valarray<double> & rInd) const
+    {
+      unsigned iSize = rValues.size();
+      unsigned iBarriers = rBarriers.size();
+      PRECONDITION(iSize > 0);
+      rInd.resize(iSize*iBarriers);
+      if (iBarriers == 0) {
+	return;
       }
-      else {
-	rValues[rValues.size()-1] = dIndLeft+0.5;
+      const double * pV = &rValues[0];
+      //a contiguous pass over the nodes for every barrier; unlike the
+      //default implementation, the values are not copied
+      for (unsigned iK=0; iK<iBarriers; iK++) {
+	double * pInd = &rInd[iK*iSize];
+	double dBarrier = rBarriers[iK];
+	for (unsigned iI=0; iI+1<iSize; iI++) {
+	  pInd[iI] = leftPart(pV[iI] - dBarrier, pV[iI+1] - dBarrier);
+	}
+	double dFirst = (pV[0] - dBarrier <= 0.) ? 0. : 0.5;
+	double dLast = (pV[iSize-1] - dBarrier <= 0.) ? 0. : 0.5;
+	addParts(pInd, iSize, dFirst, dLast);
       }
     }
   };
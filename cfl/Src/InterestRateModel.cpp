@@ -2,6 +2,7 @@
 // Implementation of classes and functions declared in the corresponding *.hpp file. 
 
 #include "cfl/InterestRateModel.hpp"
+#include "cfl/Error.hpp"
 
 using namespace cfl;
 
@@ -11,4 +12,38 @@ IInterestRateModel * pNewModel, const Extended & rExtended)
 {
   m_uExtended.assign(*m_pModel);
 }
- 
+
+Slice cfl::IInterestRateModel::discount(unsigned iEventTime, 
+					const std::vector<double> & rMaturities,
+					const std::vector<double> & rAmounts) const
+{
+  PRECONDITION(rMaturities.size() == rAmounts.size());
+  Slice uValue(this, iEventTime, 0.);
+  for (unsigned iI=0; iI<rMaturities.size(); iI++) {
+    uValue += discount(iEventTime, rMaturities[iI])*rAmounts[iI];
+  }
+  return uValue;
+}
+
+Slice cfl::InterestRateModel::discount(unsigned iEventTime, 
+				       const std::vector<double> & rMaturities,
+				       const std::vector<double> & rAmounts) const
+{
+  PRECONDITION(rMaturities.size() == rAmounts.size());
+  PRECONDITION((rMaturities.size() == 0) || 
+	       (eventTimes()[iEventTime] <= rMaturities.front()));
+  Slice uValue = m_pModel->discount(iEventTime, rMaturities, rAmounts);
+  uValue.assign(m_uExtended);
+  return uValue;
+}
+
+Slice cfl::InterestRateModel::value(unsigned iEventTime, 
+				    const Data::Schedule & rSchedule) const
+{
+  const std::vector<double> & rTime = rSchedule.paymentTimes();
+  unsigned iFirst = rSchedule.next(eventTimes()[iEventTime]);
+  std::vector<double> uTime(rTime.begin() + iFirst, rTime.end());
+  std::vector<double> uAmount(rSchedule.payments().begin() + iFirst, 
+			      rSchedule.payments().end());
+  return discount(iEventTime, uTime, uAmount);
+}
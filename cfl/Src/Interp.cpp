@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <functional>
 #include <limits>
+#include <atomic>
 #include "cfl/Interp.hpp"
 #include "cfl/Error.hpp"
 #include "cfl/Auxiliary.hpp"
@@ -12,67 +13,213 @@
 
 using namespace cfl;
 
+Function 
+cfl::IInterp::interpolate(const std::shared_ptr<const std::vector<double> > & pArg, 
+			  const std::vector<double> & rVal) const
+{
+  return interpolate(*pArg, rVal);
+}
+
+std::vector<Function> 
+cfl::IInterp::interpolate(const std::shared_ptr<const std::vector<double> > & pArg, 
+			  const std::vector<double> & rVal, unsigned iColumns) const
+{
+  unsigned iSize = pArg->size();
+  PRECONDITION(rVal.size() == iSize*iColumns);
+  std::vector<Function> uFunc;
+  uFunc.reserve(iColumns);
+  std::vector<double> uVal(iSize);
+  for (unsigned iJ=0; iJ<iColumns; iJ++) {
+    for (unsigned iI=0; iI<iSize; iI++) {
+      uVal[iI] = rVal[iI*iColumns + iJ];
+    }
+    uFunc.push_back(interpolate(pArg, uVal));
+  }
+  return uFunc;
+}
+
+double
+cfl::IInterp::value(const std::shared_ptr<const std::vector<double> > & pArg, 
+		    const double * pVal, double dX) const
+{
+  std::vector<double> uVal(pVal, pVal + pArg->size());
+  return interpolate(pArg, uVal)(dX);
+}
+
 cfl::Interp::Interp(IInterp * pNewP)
   :m_uP(pNewP)
 {}
 
 namespace cflInterp 
 {
+  //CLASS: Locator
+
+  //Finds the index i of the interval with rArg[i-1] < dX <= rArg[i],
+  //that is, the result of std::lower_bound. For uniform grids the
+  //index is computed directly; otherwise the search starts from the
+  //interval of the previous call ("hunt") and falls back to the
+  //bisection.
+  class Locator
+  {
+  public:
+    Locator(const std::vector<double> & rArg)
+      :m_rArg(rArg), m_iHint(1), m_dStep(0.)
+    {
+      if (rArg.size() < 2) {
+	return;
+      }
+      double dStep = (rArg.back() - rArg.front())/(rArg.size() - 1);
+      double dTol = 
+	std::numeric_limits<double>::epsilon()*16.*
+	std::max(std::abs(rArg.front()), std::abs(rArg.back()));
+      bool bUniform = (dStep > 0.);
+      for (unsigned iI=1; bUniform && (iI+1<rArg.size()); iI++) {
+	bUniform = (std::abs(rArg[iI] - (rArg.front() + iI*dStep)) <= dTol);
+      }
+      if (bUniform) {
+	m_dStep = dStep;
+      }
+    }
+
+    unsigned operator()(double dX) const 
+    {
+      ASSERT((dX > m_rArg.front()) && (dX <= m_rArg.back()));
+      unsigned iI = m_iHint.load(std::memory_order_relaxed);
+      if (!bracket(iI, dX)) {
+	if ((iI+1 < m_rArg.size()) && bracket(iI+1, dX)) {
+	  iI++;
+	}
+	else if (m_dStep > 0.) {
+	  double dI = std::ceil((dX - m_rArg.front())/m_dStep);
+	  iI = std::min<unsigned>(std::max(dI, 1.), m_rArg.size() - 1);
+	  //round-off correction
+	  while ((iI > 1) && (m_rArg[iI-1] >= dX)) { iI--; }
+	  while (m_rArg[iI] < dX) { iI++; }
+	}
+	else {
+	  iI = std::lower_bound(m_rArg.begin(), m_rArg.end(), dX) - m_rArg.begin();
+	}
+	m_iHint.store(iI, std::memory_order_relaxed);
+      }
+      POSTCONDITION((iI>0) && (iI < m_rArg.size()));
+      POSTCONDITION(bracket(iI, dX));
+      return iI;
+    }
+
+  private:
+    bool bracket(unsigned iI, double dX) const
+    {
+      return (m_rArg[iI-1] < dX) && (dX <= m_rArg[iI]);
+    }
+
+    const std::vector<double> & m_rArg;
+    mutable std::atomic<unsigned> m_iHint;
+    double m_dStep;
+  };
+
+  //the index i of the interval with rArg[i-1] < dX <= rArg[i] for
+  //the evaluation from the values without a Locator
+  unsigned interval(const std::vector<double> & rArg, double dX, const char * pWhere)
+  {
+    if ((dX < rArg.front()) || (dX > rArg.back())) {
+      throw(NError::range(pWhere));
+    }
+    unsigned iI = std::lower_bound(rArg.begin(), rArg.end(), dX) - rArg.begin();
+    return std::max<unsigned>(iI, 1);
+  }
+
+  //linear interpolation on the interval iI
+  inline double linear(const std::vector<double> & rArg, const double * pVal, 
+		       unsigned iI, double dX)
+  {
+    double dX1 = rArg[iI];
+    double dY1 = pVal[iI];
+    double dX2 = rArg[iI-1];
+    double dY2 = pVal[iI-1];
+    return dY1 + (dY2 - dY1)*(dX - dX1)/(dX2 - dX1);
+  }
+
+  //cubic spline with second derivatives pSD on the interval iI
+  inline double spline(const std::vector<double> & rArg, const double * pVal, 
+		       const double * pSD, unsigned iI, double dX)
+  {
+    double dX1 = rArg[iI];
+    double dDist = dX1 - rArg[iI-1];
+    double dA = (dX1 - dX)/dDist;
+    double dB = 1. - dA;
+    double dC = (dA*dA*dA - dA)*dDist*dDist/6.;
+    double dD = (dB*dB*dB - dB)*dDist*dDist/6.;
+    return dA*pVal[iI-1] + dB*pVal[iI] + dC*pSD[iI-1] + dD*pSD[iI];
+  }
+
+  //the size of the grids for which the evaluation from the values
+  //keeps the second derivatives on the stack
+  const unsigned c_iScratch = 256;
+
   class Linear: public IFunction
   {
   public:
-    Linear(const std::vector<double> & rArg, const std::vector<double> & rVal)
-      :m_uArg(rArg), m_uVal(rVal)
+    Linear(const std::shared_ptr<const std::vector<double> > & pArg, 
+	   const std::vector<double> & rVal)
+      :m_pArg(pArg), m_rArg(*pArg), m_uVal(rVal), m_uLocator(m_rArg)
     {
-      POSTCONDITION(m_uArg.size() == m_uVal.size());		
+      POSTCONDITION(m_rArg.size() == m_uVal.size());		
     }
 		
     double operator()(double dX) const 
     {
-      ASSERT(dX >= m_uArg.front());
-      ASSERT(dX <= m_uArg.back());
+      ASSERT(dX >= m_rArg.front());
+      ASSERT(dX <= m_rArg.back());
       if (belongs(dX)==false) {
 	throw(NError::range("linear interpolation"));
       }
-      if (dX == m_uArg.front()) { return m_uVal.front(); }
-      std::vector<double>::const_iterator itArg = 
-	std::lower_bound(m_uArg.begin(), m_uArg.end(), dX);
-      std::vector<double>::const_iterator itVal = 
-	m_uVal.begin() + (itArg - m_uArg.begin());
-      double dX1 = *(itArg--);
-      double dY1 = *(itVal--);
-      double dX2 = *itArg;
-      double dY2 = *itVal;
-	
-      return dY1 + (dY2 - dY1)*(dX - dX1)/(dX2 - dX1);			
+      if (dX == m_rArg.front()) { return m_uVal.front(); }
+      return linear(m_rArg, m_uVal.data(), m_uLocator(dX), dX);
+    }
+
+    static double value(const std::shared_ptr<const std::vector<double> > & pArg, 
+			const double * pVal, double dX)
+    {
+      const std::vector<double> & rArg = *pArg;
+      unsigned iI = interval(rArg, dX, "linear interpolation");
+      if (rArg.size() == 1) { return pVal[0]; }
+      return linear(rArg, pVal, iI, dX);
     }
 		
     bool belongs(double dX) const 
     { 
-      return (dX>=m_uArg.front())&&(dX<=m_uArg.back()); 
+      return (dX>=m_rArg.front())&&(dX<=m_rArg.back()); 
+    }
+
+    void evaluate(const double * pX, double * pY, size_t iSize) const 
+    {
+      for (size_t iI=0; iI<iSize; iI++) {
+	pY[iI] = Linear::operator()(pX[iI]);
+      }
     }
 		
   private:
-    std::vector<double> m_uArg, m_uVal;
+    std::shared_ptr<const std::vector<double> > m_pArg;
+    const std::vector<double> & m_rArg;
+    std::vector<double> m_uVal;
+    Locator m_uLocator;
   };
 
-  class Spline: public IFunction
+  //CLASS: SplineBasis
+
+  //The tridiagonal system for the second derivatives of natural cubic
+  //splines on a fixed grid. It is factored once and solved for many
+  //vectors of values.
+  class SplineBasis
   {
   public:
-    Spline(const std::vector<double> & rArg, const std::vector<double> & rVal)
-      :m_uArg(rArg), m_uVal(rVal), m_uSD(rArg.size(), 0.)
+    SplineBasis(const std::shared_ptr<const std::vector<double> > & pArg)
+      :m_pArg(pArg)
     {
-      ASSERT(m_uArg.size() == m_uVal.size());	
-      ASSERT(m_uArg.size() >= 3);
-			
-      //calculate the vector of second derivatives
+      const std::vector<double> & rArg = *m_pArg;
+      ASSERT(rArg.size() >= 3);
       int iSize = rArg.size();
-      if (iSize == 3) {
-	m_uSD[1] = 3.* ((rVal[2] - rVal[1])/(rArg[2] - rArg[1])
-			- (rVal[1] - rVal[0])/(rArg[1] - rArg[0]))
-	  /(rArg[2] - rArg[0]);
-      }
-      else if (iSize > 3) {
+      if (iSize > 3) {
 	//define tridiagonal matrix
 	std::valarray<double> uL(iSize-3);
 	std::transform(rArg.begin()+2, rArg.end()-1, rArg.begin()+1, 
@@ -84,78 +231,379 @@ namespace cflInterp
 		       std::minus<double>());
 	uD/=3.;
 
-	Tridiag uTridiag(uL,uD,uL);
-	std::valarray<double> uR(iSize-2);
-	for (unsigned int iI=0; iI<uR.size(); iI++) {
-	  uR[iI] = (rVal[iI+2] - rVal[iI+1])/(rArg[iI+2] - rArg[iI+1])
-	    - (rVal[iI+1] - rVal[iI])/(rArg[iI+1] - rArg[iI]);
+	m_uTridiag.assign(uL,uD,uL);
+      }
+    }
+
+    const std::shared_ptr<const std::vector<double> > & arg() const 
+    {
+      return m_pArg;
+    }
+
+    //second derivatives for one vector of values; pSD has the size of
+    //the grid
+    void secondDerivatives(const double * pVal, double * pSD) const
+    {
+      const std::vector<double> & rArg = *m_pArg;
+      unsigned iSize = rArg.size();
+      pSD[0] = 0.;
+      pSD[iSize-1] = 0.;
+      if (iSize == 3) {
+	pSD[1] = 3.* ((pVal[2] - pVal[1])/(rArg[2] - rArg[1])
+		      - (pVal[1] - pVal[0])/(rArg[1] - rArg[0]))
+	  /(rArg[2] - rArg[0]);
+	return;
+      }
+      for (unsigned int iI=0; iI+2<iSize; iI++) {
+	pSD[iI+1] = (pVal[iI+2] - pVal[iI+1])/(rArg[iI+2] - rArg[iI+1])
+	  - (pVal[iI+1] - pVal[iI])/(rArg[iI+1] - rArg[iI]);
+      }
+      m_uTridiag.solve(pSD + 1);
+    }
+
+    //second derivatives for iColumns vectors of values stored row by row
+    std::valarray<double> secondDerivatives(const double * pVal, unsigned iColumns) const
+    {
+      const std::vector<double> & rArg = *m_pArg;
+      unsigned iSize = rArg.size();
+      std::valarray<double> uSD(0., iSize*iColumns);
+      if (iSize == 3) {
+	for (unsigned iJ=0; iJ<iColumns; iJ++) {
+	  const double * pV = pVal + iJ;
+	  uSD[iColumns + iJ] = 
+	    3.* ((pV[2*iColumns] - pV[iColumns])/(rArg[2] - rArg[1])
+		 - (pV[iColumns] - pV[0])/(rArg[1] - rArg[0]))
+	    /(rArg[2] - rArg[0]);
+	}
+      }
+      else {
+	std::valarray<double> uR((iSize-2)*iColumns);
+	for (unsigned int iI=0; iI+2<iSize; iI++) {
+	  const double * pV = pVal + iI*iColumns;
+	  for (unsigned iJ=0; iJ<iColumns; iJ++) {
+	    uR[iI*iColumns + iJ] = 
+	      (pV[2*iColumns + iJ] - pV[iColumns + iJ])/(rArg[iI+2] - rArg[iI+1])
+	      - (pV[iColumns + iJ] - pV[iJ])/(rArg[iI+1] - rArg[iI]);
+	  }
 	}
-	uTridiag.solve(uR);
-	std::copy(begin(uR), end(uR), m_uSD.begin()+1);
+	m_uTridiag.solve(uR, iColumns);
+	uSD[std::slice(iColumns, uR.size(), 1)] = uR;
       }
+      return uSD;
+    }
+
+  private:
+    std::shared_ptr<const std::vector<double> > m_pArg;
+    Tridiag m_uTridiag;
+  };
+
+  class Spline: public IFunction
+  {
+  public:
+    Spline(const std::shared_ptr<const std::vector<double> > & pArg, 
+	   const std::vector<double> & rVal)
+      :m_pArg(pArg), m_rArg(*pArg), m_uVal(rVal), m_uLocator(m_rArg)
+    {
+      ASSERT(m_rArg.size() == m_uVal.size());	
+      ASSERT(m_rArg.size() >= 3);
+      std::valarray<double> uSD = SplineBasis(pArg).secondDerivatives(m_uVal.data(), 1);
+      m_uSD.assign(begin(uSD), end(uSD));
+    }
+
+    Spline(const std::shared_ptr<const std::vector<double> > & pArg, 
+	   const std::vector<double> & rVal, const std::vector<double> & rSD)
+      :m_pArg(pArg), m_rArg(*pArg), m_uVal(rVal), m_uSD(rSD), 
+       m_uLocator(m_rArg)
+    {
+      ASSERT(m_rArg.size() == m_uVal.size());	
+      ASSERT(m_rArg.size() == m_uSD.size());	
     }
 		
     double operator()(double dX) const 
     {
-      ASSERT(dX >= m_uArg.front());
-      ASSERT(dX <= m_uArg.back());
+      ASSERT(dX >= m_rArg.front());
+      ASSERT(dX <= m_rArg.back());
       if (belongs(dX)==false) {
 	throw(NError::range("spline interpolation"));
       }
-      if (dX == m_uArg.front()) { return m_uVal.front(); }
-			
-      std::vector<double>::const_iterator itArg = 
-	std::lower_bound(m_uArg.begin(), m_uArg.end(), dX);
-
-      std::vector<double>::const_iterator itVal = 
-	m_uVal.begin() + (itArg - m_uArg.begin());
-      std::vector<double>::const_iterator itSD = 
-	m_uSD.begin() + (itArg-m_uArg.begin());
-			
-      ASSERT(itArg > m_uArg.begin());
-
-      double dX1 = *(itArg--);
-      double dY1 = *(itVal--);
-      double dSD1 = *(itSD--);
-      double dX2 = *itArg;
-      double dY2 = *itVal;
-      double dSD2 = *itSD;
-			
-      double dDist = dX1 - dX2;
-      double dA = (dX1 - dX)/dDist;
-      double dB = 1. - dA;
-      double dC = (dA*dA*dA - dA)*dDist*dDist/6.;
-      double dD = (dB*dB*dB - dB)*dDist*dDist/6.;
-			
-      double dResult = dA*dY2 + dB*dY1 + dC*dSD2 + dD*dSD1;
-      return dResult;		
+      if (dX == m_rArg.front()) { return m_uVal.front(); }
+      return spline(m_rArg, m_uVal.data(), m_uSD.data(), m_uLocator(dX), dX);
+    }
+
+    static double value(const SplineBasis & rBasis, const double * pVal, double dX)
+    {
+      const std::vector<double> & rArg = *rBasis.arg();
+      unsigned iI = interval(rArg, dX, "spline interpolation");
+      Scratch<c_iScratch> uSD(rArg.size());
+      rBasis.secondDerivatives(pVal, uSD.begin());
+      return spline(rArg, pVal, uSD.begin(), iI, dX);
+    }
+
+    static double value(const std::shared_ptr<const std::vector<double> > & pArg, 
+			const double * pVal, double dX)
+    {
+      return value(SplineBasis(pArg), pVal, dX);
     }
 		
     bool belongs(double dX) const { 
-      return (dX>=m_uArg.front())&&(dX<=m_uArg.back()); 
+      return (dX>=m_rArg.front())&&(dX<=m_rArg.back()); 
+    }
+
+    void evaluate(const double * pX, double * pY, size_t iSize) const 
+    {
+      for (size_t iI=0; iI<iSize; iI++) {
+	pY[iI] = Spline::operator()(pX[iI]);
+      }
     }
 		
   private:
-    std::vector<double> m_uArg, m_uVal, m_uSD;
+    std::shared_ptr<const std::vector<double> > m_pArg;
+    const std::vector<double> & m_rArg;
+    std::vector<double> m_uVal, m_uSD;
+    Locator m_uLocator;
   };
 
   template <class InterpFunc> 
   class Helper: public IInterp
   {
   public:
+    using IInterp::interpolate;
+
     Function interpolate(const std::vector<double> & rArg, 
 			 const std::vector<double> & rVal) const 
     {
-      if (rArg.size() <=2) {
-	return Function(new Linear(rArg, rVal));
+      return interpolate(std::make_shared<const std::vector<double> >(rArg), rVal);
+    }
+
+    Function interpolate(const std::shared_ptr<const std::vector<double> > & pArg, 
+			 const std::vector<double> & rVal) const 
+    {
+      if (pArg->size() <=2) {
+	return Function(new Linear(pArg, rVal));
       }
       else {
-	return Function(new InterpFunc(rArg, rVal));
+	return Function(new InterpFunc(pArg, rVal));
+      }
+    }
+
+    double value(const std::shared_ptr<const std::vector<double> > & pArg, 
+		 const double * pVal, double dX) const
+    {
+      if (pArg->size() <=2) {
+	return Linear::value(pArg, pVal, dX);
+      }
+      return InterpFunc::value(pArg, pVal, dX);
+    }
+  };
+
+  //CLASS: FastSpline
+
+  //Natural cubic spline which keeps the factored basis of the last
+  //grid and reuses it while the grid stays the same.
+  class FastSpline: public IInterp
+  {
+  public:
+    Function interpolate(const std::vector<double> & rArg, 
+			 const std::vector<double> & rVal) const 
+    {
+      return interpolate(std::make_shared<const std::vector<double> >(rArg), rVal);
+    }
+
+    Function interpolate(const std::shared_ptr<const std::vector<double> > & pArg, 
+			 const std::vector<double> & rVal) const 
+    {
+      return interpolate(pArg, rVal, 1).front();
+    }
+
+    std::vector<Function> 
+    interpolate(const std::shared_ptr<const std::vector<double> > & pArg, 
+		const std::vector<double> & rVal, unsigned iColumns) const
+    {
+      unsigned iSize = pArg->size();
+      PRECONDITION(rVal.size() == iSize*iColumns);
+      std::vector<Function> uFunc;
+      uFunc.reserve(iColumns);
+      std::vector<double> uVal(iSize);
+      if (iSize <= 2) {
+	for (unsigned iJ=0; iJ<iColumns; iJ++) {
+	  for (unsigned iI=0; iI<iSize; iI++) {
+	    uVal[iI] = rVal[iI*iColumns + iJ];
+	  }
+	  uFunc.push_back(Function(new Linear(pArg, uVal)));
+	}
+	return uFunc;
+      }
+      std::shared_ptr<const SplineBasis> pBasis = basis(pArg);
+      std::valarray<double> uSD = pBasis->secondDerivatives(rVal.data(), iColumns);
+      std::vector<double> uColSD(iSize);
+      for (unsigned iJ=0; iJ<iColumns; iJ++) {
+	for (unsigned iI=0; iI<iSize; iI++) {
+	  uVal[iI] = rVal[iI*iColumns + iJ];
+	  uColSD[iI] = uSD[iI*iColumns + iJ];
+	}
+	uFunc.push_back(Function(new Spline(pBasis->arg(), uVal, uColSD)));
+      }
+      return uFunc;
+    }
+
+    double value(const std::shared_ptr<const std::vector<double> > & pArg, 
+		 const double * pVal, double dX) const
+    {
+      if (pArg->size() <= 2) {
+	return Linear::value(pArg, pVal, dX);
+      }
+      return Spline::value(*basis(pArg), pVal, dX);
+    }
+
+  private:
+    std::shared_ptr<const SplineBasis> 
+    basis(const std::shared_ptr<const std::vector<double> > & pArg) const
+    {
+      std::shared_ptr<const SplineBasis> pBasis = std::atomic_load(&m_pBasis);
+      if (!pBasis || ((pBasis->arg() != pArg) && (*pBasis->arg() != *pArg))) {
+	pBasis = std::make_shared<const SplineBasis>(pArg);
+	std::atomic_store(&m_pBasis, pBasis);
       }
+      return pBasis;
     }
+
+    mutable std::shared_ptr<const SplineBasis> m_pBasis;
   };
 }
 
+namespace cflInterp 
+{
+  //CLASS: Table
+
+  //Piecewise cubic function on a two-level uniform grid. The domain
+  //is split into equal cells and every cell into 2^k equal pieces;
+  //on every piece the function is the cubic polynomial interpolating
+  //the values at the points 0, 1/3, 2/3 and 1 of the piece.
+  class Table: public IFunction
+  {
+  public:
+    Table(const Function & rF, double dLeft, double dRight, 
+	  double dTolerance, unsigned iCells)
+      :m_dL(dLeft), m_dR(dRight), m_uFirst(iCells+1), m_uScale(iCells)
+    {
+      PRECONDITION(dLeft < dRight);
+      PRECONDITION(iCells > 0);
+      PRECONDITION(dTolerance > 0.);
+      const unsigned c_iMaxLevel = 12;
+      m_dH = (dRight - dLeft)/iCells;
+      for (unsigned iC=0; iC<iCells; iC++) {
+	double dA = dLeft + iC*m_dH;
+	std::vector<double> uCoeff;
+	unsigned iPieces = 1;
+	unsigned iLevel = 0;
+	while (!fit(rF, dA, m_dH/iPieces, iPieces, dTolerance, uCoeff)) {
+	  if (iLevel == c_iMaxLevel) {
+	    throw(NError::range("tolerance of tabulated function"));
+	  }
+	  iLevel++;
+	  iPieces *= 2;
+	}
+	m_uFirst[iC] = m_uCoeff.size()/4;
+	m_uScale[iC] = iPieces/m_dH;
+	m_uCoeff.insert(m_uCoeff.end(), uCoeff.begin(), uCoeff.end());
+      }
+      m_uFirst[iCells] = m_uCoeff.size()/4;
+    }
+
+    double operator()(double dX) const 
+    {
+      if (!belongs(dX)) {
+	throw(NError::range("tabulated function"));
+      }
+      unsigned iCells = m_uScale.size();
+      unsigned iC = std::min<unsigned>((dX - m_dL)/m_dH, iCells - 1);
+      double dY = (dX - m_dL - iC*m_dH)*m_uScale[iC];
+      unsigned iLast = m_uFirst[iC+1] - m_uFirst[iC] - 1;
+      unsigned iP = std::min<unsigned>(std::max(dY, 0.), iLast);
+      const double * pC = &m_uCoeff[4*(m_uFirst[iC] + iP)];
+      double dT = dY - iP;
+      return pC[0] + dT*(pC[1] + dT*(pC[2] + dT*pC[3]));
+    }
+
+    void evaluate(const double * pX, double * pY, size_t iSize) const 
+    {
+      for (size_t iI=0; iI<iSize; iI++) {
+	pY[iI] = Table::operator()(pX[iI]);
+      }
+    }
+
+    bool belongs(double dX) const 
+    {
+      return (dX >= m_dL) && (dX <= m_dR);
+    }
+
+  private:
+    //fits iPieces cubic polynomials on [dA, dA+iPieces*dH]; returns
+    //true if the tolerance is met
+    static bool fit(const Function & rF, double dA, double dH, unsigned iPieces, 
+		    double dTolerance, std::vector<double> & rCoeff)
+    {
+      rCoeff.resize(4*iPieces);
+      bool bFit = true;
+      for (unsigned iP=0; iP<iPieces; iP++) {
+	double dX = dA + iP*dH;
+	double dY0 = rF(dX);
+	double dY1 = rF(dX + dH/3.);
+	double dY2 = rF(dX + 2.*dH/3.);
+	double dY3 = rF(dX + dH);
+	//power form in t = (x - dX)/dH of the cubic through the nodes 0, 1/3, 2/3, 1
+	double * pC = &rCoeff[4*iP];
+	pC[0] = dY0;
+	pC[1] = (-11.*dY0 + 18.*dY1 - 9.*dY2 + 2.*dY3)/2.;
+	pC[2] = 9.*(2.*dY0 - 5.*dY1 + 4.*dY2 - dY3)/2.;
+	pC[3] = 9.*(-dY0 + 3.*dY1 - 3.*dY2 + dY3)/2.;
+	//the test points are the midpoints between the nodes; the error
+	//between them is controlled with the factor 1/2 of the tolerance
+	if (bFit) {
+	  for (unsigned iT=1; iT<6; iT+=2) {
+	    double dT = iT/6.;
+	    double dF = rF(dX + dT*dH);
+	    double dP = pC[0] + dT*(pC[1] + dT*(pC[2] + dT*pC[3]));
+	    if (std::abs(dF - dP) > 0.5*dTolerance*std::max(1., std::abs(dF))) {
+	      bFit = false;
+	    }
+	  }
+	}
+      }
+      return bFit;
+    }
+
+    double m_dL, m_dR, m_dH;
+    std::vector<unsigned> m_uFirst;
+    std::vector<double> m_uScale, m_uCoeff;
+  };
+}
+
+cfl::Function 
+cfl::tabulate(const Function & rF, double dLeft, double dRight, 
+	      double dTolerance, unsigned iCells)
+{
+  return Function(new cflInterp::Table(rF, dLeft, dRight, dTolerance, iCells));
+}
+
+cfl::Function 
+cfl::seed(const Interp & rInterp, const std::vector<double> & rArg, 
+	  const std::vector<double> & rVal, unsigned iFirst)
+{
+  PRECONDITION(rArg.size() == rVal.size());
+  std::shared_ptr<const std::vector<double> > 
+    pArg(new std::vector<double>(rArg));
+  //every interpolation is linear in the values; the derivatives are
+  //interpolated unit vectors
+  unsigned iN = rArg.size();
+  std::vector<double> uUnit(iN*iN, 0.);
+  for (unsigned iI=0; iI<iN; iI++) {
+    uUnit[iI*iN + iI] = 1.;
+  }
+  return seed(rInterp.interpolate(pArg, rVal.begin()), 
+	      rInterp.interpolate(pArg, uUnit, iN), iFirst);
+}
+
 cfl::Interp cfl::NInterp::linear() 
 {
   return Interp(new cflInterp::Helper<cflInterp::Linear>());
@@ -165,3 +613,8 @@ cfl::Interp cfl::NInterp::spline()
 {
   return Interp(new cflInterp::Helper<cflInterp::Spline>());
 }
+
+cfl::Interp cfl::NInterp::fastSpline() 
+{
+  return Interp(new cflInterp::FastSpline());
+}
@@ -0,0 +1,80 @@
+// Implementation of classes and functions declared in the corresponding *.hpp file. 
+
+#include <algorithm>
+#include <iterator>
+#include "cfl/Model.hpp"
+#include "cfl/Slice.hpp"
+#include "cfl/Error.hpp"
+
+using namespace cfl;
+
+// CLASS: IModel
+
+std::vector<Slice> 
+cfl::IModel::indicator(const Slice & rSlice, const std::vector<double> & rBarriers) const
+{
+  PRECONDITION(rSlice.ptrToModel() == this);
+  std::vector<Slice> uInd(rBarriers.size(), rSlice);
+  for (unsigned iK=0; iK<rBarriers.size(); iK++) {
+    indicator(uInd[iK], rBarriers[iK]);
+  }
+  return uInd;
+}
+
+void cfl::IModel::rollback(std::vector<Slice> & rSlices, unsigned iEventTime) const
+{
+  for (unsigned iI=0; iI<rSlices.size(); iI++) {
+    PRECONDITION(rSlices[iI].ptrToModel() == this);
+    rollback(rSlices[iI], iEventTime);
+  }
+}
+
+void cfl::IModel::rollback(Slice & rSlice, unsigned iEventTime,
+			   const Slice & rStart, const Slice & rEnd,
+			   double dLowerBarrier, double dUpperBarrier) const
+{
+  PRECONDITION(rSlice.ptrToModel() == this);
+  PRECONDITION(rStart.timeIndex() == iEventTime);
+  PRECONDITION(rEnd.timeIndex() == rSlice.timeIndex());
+  PRECONDITION(dLowerBarrier < dUpperBarrier);
+  std::vector<double> uBarriers(2);
+  uBarriers[0] = dLowerBarrier;
+  uBarriers[1] = dUpperBarrier;
+  std::vector<Slice> uInd = indicator(rEnd, uBarriers);
+  rSlice *= uInd[0] - uInd[1];
+  rollback(rSlice, iEventTime);
+  uInd = indicator(rStart, uBarriers);
+  rSlice *= uInd[0] - uInd[1];
+}
+
+// FUNCTION: merge
+
+std::vector<double> cfl::merge(const std::vector<double> & rTimes1, 
+			       const std::vector<double> & rTimes2)
+{
+  PRECONDITION(std::is_sorted(rTimes1.begin(), rTimes1.end()));
+  PRECONDITION(std::is_sorted(rTimes2.begin(), rTimes2.end()));
+  std::vector<double> uTimes;
+  uTimes.reserve(rTimes1.size() + rTimes2.size());
+  std::set_union(rTimes1.begin(), rTimes1.end(), rTimes2.begin(), rTimes2.end(), 
+		 std::back_inserter(uTimes));
+  uTimes.erase(std::unique(uTimes.begin(), uTimes.end()), uTimes.end());
+  return uTimes;
+}
+
+// FUNCTION: eventIndexes
+
+std::vector<unsigned> cfl::eventIndexes(const std::vector<double> & rEventTimes, 
+					const std::vector<double> & rTimes)
+{
+  std::vector<unsigned> uIndexes(rTimes.size());
+  for (unsigned iI=0; iI<rTimes.size(); iI++) {
+    std::vector<double>::const_iterator itT = 
+      std::lower_bound(rEventTimes.begin(), rEventTimes.end(), rTimes[iI]);
+    if ((itT == rEventTimes.end()) || (*itT != rTimes[iI])) {
+      throw(NError::range("event time"));
+    }
+    uIndexes[iI] = itT - rEventTimes.begin();
+  }
+  return uIndexes;
+}
@@ -12,6 +12,20 @@
 using namespace cfl;
 using namespace std;
 
+// CLASS: IMultiFunction
+
+double cfl::IMultiFunction::operator()(const double * pX) const
+{
+  std::valarray<double> uX(pX, dim());
+  return (*this)(uX);
+}
+
+bool cfl::IMultiFunction::belongs(const double * pX) const
+{
+  std::valarray<double> uX(pX, dim());
+  return belongs(uX);
+}
+
 cfl::MultiFunction::MultiFunction(IMultiFunction * pNewF)
   :m_pF(pNewF)
 {}
@@ -38,6 +52,14 @@ namespace cflMultiFunction
       PRECONDITION(rX.size() == m_iDim);
       return true; 
     }
+    double operator()(const double *) const 
+    { 
+      return m_dConst; 
+    }	
+    bool belongs(const double *) const 
+    { 
+      return true; 
+    }
     unsigned dim() const 
     { 
       return m_iDim; 
@@ -68,6 +90,14 @@ namespace cflMultiFunction
       PRECONDITION(rX.size() == m_uFunc.dim());
       return m_uFunc.belongs(rX); 
     }
+    double operator()(const double * pX) const 
+    {
+      return m_uUnOp(m_uFunc(pX)); 
+    }
+    bool belongs(const double * pX) const 
+    { 
+      return m_uFunc.belongs(pX); 
+    }
     unsigned dim() const 
     { 
       return m_uFunc.dim(); 
@@ -103,6 +133,16 @@ namespace cflMultiFunction
       return (m_uFunc1.belongs(rX))&&(m_uFunc2.belongs(rX)); 
     }
 
+    double operator()(const double * pX) const 
+    { 
+      return m_uBinOp(m_uFunc1(pX), m_uFunc2(pX)); 
+    }
+
+    bool belongs(const double * pX) const 
+    { 
+      return (m_uFunc1.belongs(pX))&&(m_uFunc2.belongs(pX)); 
+    }
+
     unsigned dim() const 
     { 
       return m_uFunc1.dim(); 
@@ -386,6 +426,15 @@ namespace cflMultiFunction
       PRECONDITION(rX.size() == m_iDim);
       return m_uFunc.belongs(rX[m_iArgIndex]);
     }
+    double operator()(const double * pX) const 
+    {
+      PRECONDITION(belongs(pX));
+      return m_uFunc(pX[m_iArgIndex]);
+    }
+    bool belongs(const double * pX) const 
+    {
+      return m_uFunc.belongs(pX[m_iArgIndex]);
+    }
     unsigned dim() const { return m_iDim; }
 
   private:
@@ -416,38 +465,47 @@ namespace cflMultiFunction
     double operator()(const std::valarray<double> & rX) const 
     {
       PRECONDITION(rX.size() == m_uState.size());
-      PRECONDITION(belongs(rX));
-      return m_uFunc(extend(rX));
+      return (*this)(cfl::begin(rX));
     }
     bool belongs(const std::valarray<double> & rX) const 
     {
       PRECONDITION(rX.size() == dim());
-      return m_uFunc.belongs(extend(rX));
+      return belongs(cfl::begin(rX));
+    }
+    double operator()(const double * pX) const 
+    {
+      PRECONDITION(belongs(pX));
+      Scratch<c_iScratch> uP(m_uFunc.dim());
+      extend(pX, uP.begin());
+      return m_uFunc(uP.begin());
+    }
+    bool belongs(const double * pX) const 
+    {
+      Scratch<c_iScratch> uP(m_uFunc.dim());
+      extend(pX, uP.begin());
+      return m_uFunc.belongs(uP.begin());
     }
     unsigned dim() const { 
       return m_uState.size(); 
     }
 
   private:
+    static const unsigned c_iScratch = 32;
     MultiFunction m_uFunc;
     std::vector<unsigned> m_uState;
     std::valarray<double> m_uPoint; 
-    std::valarray<double> extend(const std::valarray<double> & rX) const 
+    void extend(const double * pX, double * pP) const 
     {
-      ASSERT(rX.size() == m_uState.size());
-      std::valarray<double> uP(m_uFunc.dim());
-      ASSERT(uP.size()>= rX.size());
       unsigned int iJ=0;
       unsigned int iK=0;
-      for (unsigned int iI=0; iI<uP.size(); iI++) {
+      for (unsigned int iI=0; iI<m_uFunc.dim(); iI++) {
 	if ((iJ<m_uState.size())&&(m_uState[iJ]==iI)) {
-	  uP[iI] = rX[iJ++];
+	  pP[iI] = pX[iJ++];
 	}
 	else {
-	  uP[iI] = m_uPoint[iK++];
+	  pP[iI] = m_uPoint[iK++];
 	}
       }
-      return uP;
     }
   };
 }
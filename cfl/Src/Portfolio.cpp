@@ -0,0 +1,161 @@
+// Implementation of classes and functions declared in the corresponding *.hpp file.
+
+#include "cfl/Portfolio.hpp"
+#include "cfl/Error.hpp"
+
+using namespace cfl;
+
+// CLASS: Trade
+
+cfl::Trade::Trade(ITrade * pNewP)
+  :m_uP(pNewP)
+{}
+
+namespace cflPortfolio
+{
+  class Trade: public ITrade
+  {
+  public:
+    Trade(const std::vector<double> & rEventTimes, unsigned iSlices,
+	  const std::function<void(std::vector<Slice> &, unsigned)> & rEvent)
+      :m_uEventTimes(rEventTimes), m_iSlices(iSlices), m_uEvent(rEvent)
+    {
+      PRECONDITION(m_uEventTimes.size() > 0);
+      PRECONDITION(m_iSlices > 0);
+    }
+
+    const std::vector<double> & eventTimes() const
+    {
+      return m_uEventTimes;
+    }
+
+    unsigned numberOfSlices() const
+    {
+      return m_iSlices;
+    }
+
+    void event(std::vector<Slice> & rValues, unsigned iEventTime) const
+    {
+      PRECONDITION(rValues.size() == m_iSlices);
+      m_uEvent(rValues, iEventTime);
+    }
+
+  private:
+    std::vector<double> m_uEventTimes;
+    unsigned m_iSlices;
+    std::function<void(std::vector<Slice> &, unsigned)> m_uEvent;
+  };
+
+  std::vector<MultiFunction> interpolate(const std::vector<Slice> & rValues)
+  {
+    std::vector<MultiFunction> uPrices;
+    uPrices.reserve(rValues.size());
+    for (unsigned iI=0; iI<rValues.size(); iI++) {
+      uPrices.push_back(cfl::interpolate(rValues[iI]));
+    }
+    return uPrices;
+  }
+}
+
+cfl::Trade cfl::toTrade(const std::vector<double> & rEventTimes,
+			const std::function<void(Slice &, unsigned)> & rEvent)
+{
+  std::function<void(Slice &, unsigned)> uEvent(rEvent);
+  return toTrade(rEventTimes, 1,
+		 [uEvent](std::vector<Slice> & rValues, unsigned iTime)
+		 { uEvent(rValues.front(), iTime); });
+}
+
+cfl::Trade cfl::toTrade(const std::vector<double> & rEventTimes, unsigned iSlices,
+			const std::function<void(std::vector<Slice> &, unsigned)> & rEvent)
+{
+  return Trade(new cflPortfolio::Trade(rEventTimes, iSlices, rEvent));
+}
+
+// FUNCTION: eventTimes
+
+std::vector<double> cfl::eventTimes(const std::vector<Trade> & rTrades,
+				    double dInitialTime)
+{
+  std::vector<double> uEventTimes(1, dInitialTime);
+  for (unsigned iI=0; iI<rTrades.size(); iI++) {
+    PRECONDITION(rTrades[iI].eventTimes().front() >= dInitialTime);
+    uEventTimes = merge(uEventTimes, rTrades[iI].eventTimes());
+  }
+  return uEventTimes;
+}
+
+// FUNCTION: sweep
+
+std::vector<Slice> cfl::sweep(const std::vector<Trade> & rTrades, const Slice & rZero)
+{
+  const IModel * pModel = rZero.ptrToModel();
+  const std::vector<double> & rEventTimes = pModel->eventTimes();
+
+  //uEvents[t] are the trades with an event at the event time t
+  std::vector<std::vector<unsigned> > uEvents(rEventTimes.size());
+  for (unsigned iI=0; iI<rTrades.size(); iI++) {
+    std::vector<unsigned> uIndexes = eventIndexes(rEventTimes, rTrades[iI].eventTimes());
+    for (unsigned iK=0; iK<uIndexes.size(); iK++) {
+      uEvents[uIndexes[iK]].push_back(iI);
+    }
+  }
+
+  //a trade is live from its last event time; the values of all live
+  //trades are swapped into one vector for the rollback and back
+  std::vector<std::vector<Slice> > uValues(rTrades.size());
+  std::vector<unsigned> uLive;
+  std::vector<Slice> uAll;
+  for (int iTime=rEventTimes.size()-1; iTime>=0; iTime--) {
+    for (unsigned iK=0; iK<uEvents[iTime].size(); iK++) {
+      unsigned iI = uEvents[iTime][iK];
+      if (uValues[iI].size() == 0) {
+	uValues[iI].assign(rTrades[iI].numberOfSlices(), Slice(pModel, iTime, 0.));
+	uLive.push_back(iI);
+      }
+      rTrades[iI].event(uValues[iI], iTime);
+    }
+    if ((iTime > 0) && (uLive.size() > 0)) {
+      uAll.clear();
+      for (unsigned iK=0; iK<uLive.size(); iK++) {
+	std::vector<Slice> & rValues = uValues[uLive[iK]];
+	for (unsigned iJ=0; iJ<rValues.size(); iJ++) {
+	  uAll.push_back(Slice());
+	  uAll.back().swap(rValues[iJ]);
+	}
+      }
+      rollback(uAll, iTime-1);
+      std::vector<Slice>::iterator itAll = uAll.begin();
+      for (unsigned iK=0; iK<uLive.size(); iK++) {
+	std::vector<Slice> & rValues = uValues[uLive[iK]];
+	for (unsigned iJ=0; iJ<rValues.size(); iJ++, itAll++) {
+	  rValues[iJ].swap(*itAll);
+	}
+      }
+    }
+  }
+
+  std::vector<Slice> uResult;
+  uResult.reserve(rTrades.size());
+  for (unsigned iI=0; iI<rTrades.size(); iI++) {
+    ASSERT(uValues[iI].size() > 0);
+    uResult.push_back(uValues[iI].front());
+  }
+  return uResult;
+}
+
+// FUNCTION: price
+
+std::vector<MultiFunction> cfl::price(const std::vector<Trade> & rTrades,
+				      AssetModel & rModel)
+{
+  rModel.assignEventTimes(eventTimes(rTrades, rModel.initialTime()));
+  return cflPortfolio::interpolate(sweep(rTrades, rModel.cash(0, 0.)));
+}
+
+std::vector<MultiFunction> cfl::price(const std::vector<Trade> & rTrades,
+				      InterestRateModel & rModel)
+{
+  rModel.assignEventTimes(eventTimes(rTrades, rModel.initialTime()));
+  return cflPortfolio::interpolate(sweep(rTrades, rModel.cash(0, 0.)));
+}
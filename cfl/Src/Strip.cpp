@@ -0,0 +1,45 @@
+// Implementation of classes and functions declared in the corresponding *.hpp file.
+
+#include "cfl/Strip.hpp"
+#include "cfl/Error.hpp"
+
+using namespace cfl;
+
+// CLASS: Strip
+
+cfl::Strip::Strip(const Slice & rSlice, unsigned iColumns)
+  :m_uColumns(iColumns, rSlice)
+{
+  PRECONDITION(iColumns > 0);
+}
+
+cfl::Strip::Strip(const std::vector<Slice> & rColumns)
+  :m_uColumns(rColumns)
+{
+  PRECONDITION(m_uColumns.size() > 0);
+  for (unsigned iI=1; iI<m_uColumns.size(); iI++) {
+    PRECONDITION(m_uColumns[iI].ptrToModel() == m_uColumns.front().ptrToModel());
+    PRECONDITION(m_uColumns[iI].timeIndex() == m_uColumns.front().timeIndex());
+  }
+}
+
+// FUNCTIONS
+
+std::vector<MultiFunction> cfl::interpolate(const Strip & rStrip)
+{
+  std::vector<MultiFunction> uFunctions;
+  uFunctions.reserve(rStrip.size());
+  for (unsigned iI=0; iI<rStrip.size(); iI++) {
+    uFunctions.push_back(interpolate(rStrip[iI]));
+  }
+  return uFunctions;
+}
+
+std::vector<double> cfl::atOrigin(const Strip & rStrip)
+{
+  std::vector<double> uValues(rStrip.size());
+  for (unsigned iI=0; iI<rStrip.size(); iI++) {
+    uValues[iI] = atOrigin(rStrip[iI]);
+  }
+  return uValues;
+}
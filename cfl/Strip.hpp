@@ -0,0 +1,547 @@
+#ifndef __cflStrip_hpp__
+#define __cflStrip_hpp__
+
+#include <vector>
+#include "cfl/Slice.hpp"
+
+/**
+ * \file   Strip.hpp
+ *
+ * \brief Strips of random payoffs.
+ *
+ * Contains the class Strip for a family of random payoffs, one for
+ * every element of a ladder of parameters (for example, strikes).
+ * Arithmetic operations are applied column by column, while the
+ * rollback is performed for all columns at once.
+ */
+
+namespace cfl
+{
+  /// \addtogroup cflBasicElements
+  //@{
+
+  //! Strip of random payoffs.
+  /**
+   * This class represents several random payoffs (columns) defined
+   * in the same model at the same event time, for example, the values
+   * of an American option for a ladder of strikes. The exercise
+   * decisions are made column by column. The rollback is done by
+   * IModel::rollback(std::vector<Slice> &, unsigned) const, so a
+   * ladder of strikes costs about one multi-column rollback.
+   * \see Slice
+   */
+  class Strip
+  {
+  public:
+    /**
+     * Constructs the strip with \a iColumns columns equal to \a rSlice.
+     * \param rSlice The value of every column.
+     * \param iColumns The number of columns.
+     */
+    explicit Strip(const Slice & rSlice = Slice(), unsigned iColumns = 1);
+
+    /**
+     * Constructs the strip from its columns. The columns should be
+     * defined on the same model at the same event time.
+     * \param rColumns The columns of the strip.
+     */
+    explicit Strip(const std::vector<Slice> & rColumns);
+
+    /**
+     * Adds to every column of \p *this the corresponding column of \a rStrip.
+     * \param rStrip The strip with the same number of columns.
+     * \return Reference to \p *this.
+     */
+    Strip & operator+=(const Strip & rStrip);
+
+    /**
+     * Subtracts from every column of \p *this the corresponding column of \a rStrip.
+     * \param rStrip The strip with the same number of columns.
+     * \return Reference to \p *this.
+     */
+    Strip & operator-=(const Strip & rStrip);
+
+    /**
+     * Multiplies every column of \p *this on the corresponding column of \a rStrip.
+     * \param rStrip The strip with the same number of columns.
+     * \return Reference to \p *this.
+     */
+    Strip & operator*=(const Strip & rStrip);
+
+    /**
+     * Divides every column of \p *this on the corresponding column of \a rStrip.
+     * \param rStrip The strip with the same number of columns.
+     * \return Reference to \p *this.
+     */
+    Strip & operator/=(const Strip & rStrip);
+
+    /**
+     * Adds \a rSlice to every column of \p *this.
+     * \param rSlice The payoff that will be added.
+     * \return Reference to \p *this.
+     */
+    Strip & operator+=(const Slice & rSlice);
+
+    /**
+     * Subtracts \a rSlice from every column of \p *this.
+     * \param rSlice The payoff that will be subtracted.
+     * \return Reference to \p *this.
+     */
+    Strip & operator-=(const Slice & rSlice);
+
+    /**
+     * Multiplies every column of \p *this on \a rSlice.
+     * \param rSlice The multiplier.
+     * \return Reference to \p *this.
+     */
+    Strip & operator*=(const Slice & rSlice);
+
+    /**
+     * Divides every column of \p *this on \a rSlice.
+     * \param rSlice The divisor.
+     * \return Reference to \p *this.
+     */
+    Strip & operator/=(const Slice & rSlice);
+
+    /**
+     * Adds \a dValue to every column of \p *this.
+     * \param dValue The constant value that will be added.
+     * \return Reference to \p *this.
+     */
+    Strip & operator+=(double dValue);
+
+    /**
+     * Subtracts \a dValue from every column of \p *this.
+     * \param dValue The constant value that will be subtracted.
+     * \return Reference to \p *this.
+     */
+    Strip & operator-=(double dValue);
+
+    /**
+     * Multiplies every column of \p *this on \a dValue.
+     * \param dValue The constant multiplier.
+     * \return Reference to \p *this.
+     */
+    Strip & operator*=(double dValue);
+
+    /**
+     * Divides every column of \p *this on \a dValue.
+     * \param dValue The constant divisor.
+     * \return Reference to \p *this.
+     */
+    Strip & operator/=(double dValue);
+
+    /**
+     * Adds to the column \p i of \p *this the number \a rValues[i].
+     * \param rValues The constants, one for every column.
+     * \return Reference to \p *this.
+     */
+    Strip & operator+=(const std::vector<double> & rValues);
+
+    /**
+     * Subtracts from the column \p i of \p *this the number \a rValues[i].
+     * \param rValues The constants, one for every column.
+     * \return Reference to \p *this.
+     */
+    Strip & operator-=(const std::vector<double> & rValues);
+
+    /**
+     * Multiplies the column \p i of \p *this on the number \a rValues[i].
+     * \param rValues The constants, one for every column.
+     * \return Reference to \p *this.
+     */
+    Strip & operator*=(const std::vector<double> & rValues);
+
+    /**
+     * Divides the column \p i of \p *this on the number \a rValues[i].
+     * \param rValues The constants, one for every column.
+     * \return Reference to \p *this.
+     */
+    Strip & operator/=(const std::vector<double> & rValues);
+
+    /**
+     * Assigns to every column of \p *this its equivalent value at
+     * the event time with index \a iEventTime. All columns are rolled
+     * back together.
+     * \param iEventTime The index of the target event time.
+     */
+    void rollback(unsigned iEventTime);
+
+    /**
+     * Returns the number of columns.
+     * \return The number of columns of \p *this.
+     */
+    unsigned size() const;
+
+    /**
+     * Accessor function to a column.
+     * \param iColumn The index of the column.
+     * \return Constant reference to the column with index \a iColumn.
+     */
+    const Slice & operator[](unsigned iColumn) const;
+
+    /**
+     * Accessor function to a column.
+     * \param iColumn The index of the column.
+     * \return Reference to the column with index \a iColumn.
+     */
+    Slice & operator[](unsigned iColumn);
+
+    /**
+     * Accessor function to the columns.
+     * \return Constant reference to the vector of columns.
+     */
+    const std::vector<Slice> & columns() const;
+
+    /**
+     * Accessor function to the index of event time where \p *this is defined.
+     * \return Index of event time where \p *this is defined.
+     */
+    unsigned timeIndex() const;
+
+  private:
+    std::vector<Slice> m_uColumns;
+  };
+
+  /**
+   * Unary minus.
+   * \param rStrip A strip of payoffs.
+   * \return The strip with the columns <code>-rStrip[i]</code>.
+   */
+  Strip operator-(const Strip & rStrip);
+
+  /**
+   * Returns the strip with the columns <code>rStrip1[i] + rStrip2[i]</code>.
+   * \param rStrip1 The first strip.
+   * \param rStrip2 The second strip.
+   * \return The sum of the strips.
+   */
+  Strip operator+(const Strip & rStrip1, const Strip & rStrip2);
+
+  /**
+   * Returns the strip with the columns <code>rStrip1[i] - rStrip2[i]</code>.
+   * \param rStrip1 The first strip.
+   * \param rStrip2 The second strip.
+   * \return The difference of the strips.
+   */
+  Strip operator-(const Strip & rStrip1, const Strip & rStrip2);
+
+  /**
+   * Returns the strip with the columns <code>rStrip1[i] * rStrip2[i]</code>.
+   * \param rStrip1 The first strip.
+   * \param rStrip2 The second strip.
+   * \return The product of the strips.
+   */
+  Strip operator*(const Strip & rStrip1, const Strip & rStrip2);
+
+  /**
+   * Returns the strip with the columns <code>rStrip1[i] / rStrip2[i]</code>.
+   * \param rStrip1 The first strip.
+   * \param rStrip2 The second strip.
+   * \return The ratio of the strips.
+   */
+  Strip operator/(const Strip & rStrip1, const Strip & rStrip2);
+
+  /**
+   * Returns the strip with the columns <code>rStrip[i] + rSlice</code>.
+   * \param rStrip A strip of payoffs.
+   * \param rSlice A payoff.
+   * \return The sum of \a rStrip and \a rSlice.
+   */
+  Strip operator+(const Strip & rStrip, const Slice & rSlice);
+
+  /**
+   * Returns the strip with the columns <code>rStrip[i] - rSlice</code>.
+   * \param rStrip A strip of payoffs.
+   * \param rSlice A payoff.
+   * \return The difference of \a rStrip and \a rSlice.
+   */
+  Strip operator-(const Strip & rStrip, const Slice & rSlice);
+
+  /**
+   * Returns the strip with the columns <code>rStrip[i] * rSlice</code>.
+   * \param rStrip A strip of payoffs.
+   * \param rSlice A payoff.
+   * \return The product of \a rStrip and \a rSlice.
+   */
+  Strip operator*(const Strip & rStrip, const Slice & rSlice);
+
+  /**
+   * Returns the strip with the columns <code>rStrip[i] / rSlice</code>.
+   * \param rStrip A strip of payoffs.
+   * \param rSlice A payoff.
+   * \return The ratio of \a rStrip and \a rSlice.
+   */
+  Strip operator/(const Strip & rStrip, const Slice & rSlice);
+
+  /**
+   * Returns the strip with the columns <code>rSlice + rStrip[i]</code>.
+   * \param rSlice A payoff.
+   * \param rStrip A strip of payoffs.
+   * \return The sum of \a rSlice and \a rStrip.
+   */
+  Strip operator+(const Slice & rSlice, const Strip & rStrip);
+
+  /**
+   * Returns the strip with the columns <code>rSlice - rStrip[i]</code>.
+   * \param rSlice A payoff.
+   * \param rStrip A strip of payoffs.
+   * \return The difference of \a rSlice and \a rStrip.
+   */
+  Strip operator-(const Slice & rSlice, const Strip & rStrip);
+
+  /**
+   * Returns the strip with the columns <code>rSlice * rStrip[i]</code>.
+   * \param rSlice A payoff.
+   * \param rStrip A strip of payoffs.
+   * \return The product of \a rSlice and \a rStrip.
+   */
+  Strip operator*(const Slice & rSlice, const Strip & rStrip);
+
+  /**
+   * Returns the strip with the columns <code>rSlice / rStrip[i]</code>.
+   * \param rSlice A payoff.
+   * \param rStrip A strip of payoffs.
+   * \return The ratio of \a rSlice and \a rStrip.
+   */
+  Strip operator/(const Slice & rSlice, const Strip & rStrip);
+
+  /**
+   * Returns the strip with the columns <code>rStrip[i] + dValue</code>.
+   * \param rStrip A strip of payoffs.
+   * \param dValue A constant.
+   * \return The sum of \a rStrip and \a dValue.
+   */
+  Strip operator+(const Strip & rStrip, double dValue);
+
+  /**
+   * Returns the strip with the columns <code>rStrip[i] - dValue</code>.
+   * \param rStrip A strip of payoffs.
+   * \param dValue A constant.
+   * \return The difference of \a rStrip and \a dValue.
+   */
+  Strip operator-(const Strip & rStrip, double dValue);
+
+  /**
+   * Returns the strip with the columns <code>rStrip[i] * dValue</code>.
+   * \param rStrip A strip of payoffs.
+   * \param dValue A constant.
+   * \return The product of \a rStrip and \a dValue.
+   */
+  Strip operator*(const Strip & rStrip, double dValue);
+
+  /**
+   * Returns the strip with the columns <code>rStrip[i] / dValue</code>.
+   * \param rStrip A strip of payoffs.
+   * \param dValue A constant.
+   * \return The ratio of \a rStrip and \a dValue.
+   */
+  Strip operator/(const Strip & rStrip, double dValue);
+
+  /**
+   * Returns the strip with the columns <code>dValue + rStrip[i]</code>.
+   * \param dValue A constant.
+   * \param rStrip A strip of payoffs.
+   * \return The sum of \a dValue and \a rStrip.
+   */
+  Strip operator+(double dValue, const Strip & rStrip);
+
+  /**
+   * Returns the strip with the columns <code>dValue - rStrip[i]</code>.
+   * \param dValue A constant.
+   * \param rStrip A strip of payoffs.
+   * \return The difference of \a dValue and \a rStrip.
+   */
+  Strip operator-(double dValue, const Strip & rStrip);
+
+  /**
+   * Returns the strip with the columns <code>dValue * rStrip[i]</code>.
+   * \param dValue A constant.
+   * \param rStrip A strip of payoffs.
+   * \return The product of \a dValue and \a rStrip.
+   */
+  Strip operator*(double dValue, const Strip & rStrip);
+
+  /**
+   * Returns the strip with the columns <code>dValue / rStrip[i]</code>.
+   * \param dValue A constant.
+   * \param rStrip A strip of payoffs.
+   * \return The ratio of \a dValue and \a rStrip.
+   */
+  Strip operator/(double dValue, const Strip & rStrip);
+
+  /**
+   * Returns the strip with the columns <code>rSlice + rValues[i]</code>.
+   * \param rSlice A payoff.
+   * \param rValues The constants, one for every column.
+   * \return The strip with \a rValues.size() columns.
+   */
+  Strip operator+(const Slice & rSlice, const std::vector<double> & rValues);
+
+  /**
+   * Returns the strip with the columns <code>rSlice - rValues[i]</code>.
+   * \param rSlice A payoff.
+   * \param rValues The constants, one for every column.
+   * \return The strip with \a rValues.size() columns.
+   */
+  Strip operator-(const Slice & rSlice, const std::vector<double> & rValues);
+
+  /**
+   * Returns the strip with the columns <code>rSlice * rValues[i]</code>.
+   * \param rSlice A payoff.
+   * \param rValues The constants, one for every column.
+   * \return The strip with \a rValues.size() columns.
+   */
+  Strip operator*(const Slice & rSlice, const std::vector<double> & rValues);
+
+  /**
+   * Returns the strip with the columns <code>rSlice / rValues[i]</code>.
+   * \param rSlice A payoff.
+   * \param rValues The constants, one for every column.
+   * \return The strip with \a rValues.size() columns.
+   */
+  Strip operator/(const Slice & rSlice, const std::vector<double> & rValues);
+
+  /**
+   * Returns the strip with the columns <code>rValues[i] + rSlice</code>.
+   * \param rValues The constants, one for every column.
+   * \param rSlice A payoff.
+   * \return The strip with \a rValues.size() columns.
+   */
+  Strip operator+(const std::vector<double> & rValues, const Slice & rSlice);
+
+  /**
+   * Returns the strip with the columns <code>rValues[i] - rSlice</code>.
+   * For example, the payoffs of puts for the strikes \a rValues.
+   * \param rValues The constants, one for every column.
+   * \param rSlice A payoff.
+   * \return The strip with \a rValues.size() columns.
+   */
+  Strip operator-(const std::vector<double> & rValues, const Slice & rSlice);
+
+  /**
+   * Returns the strip with the columns <code>rValues[i] * rSlice</code>.
+   * \param rValues The constants, one for every column.
+   * \param rSlice A payoff.
+   * \return The strip with \a rValues.size() columns.
+   */
+  Strip operator*(const std::vector<double> & rValues, const Slice & rSlice);
+
+  /**
+   * Returns the strip with the columns <code>rValues[i] / rSlice</code>.
+   * \param rValues The constants, one for every column.
+   * \param rSlice A payoff.
+   * \return The strip with \a rValues.size() columns.
+   */
+  Strip operator/(const std::vector<double> & rValues, const Slice & rSlice);
+
+  /**
+   * Returns the strip with the columns <code>max(rStrip1[i], rStrip2[i])</code>.
+   * \param rStrip1 The first strip.
+   * \param rStrip2 The second strip.
+   * \return The maximum of the strips taken column by column.
+   */
+  Strip max(const Strip & rStrip1, const Strip & rStrip2);
+
+  /**
+   * Returns the strip with the columns <code>min(rStrip1[i], rStrip2[i])</code>.
+   * \param rStrip1 The first strip.
+   * \param rStrip2 The second strip.
+   * \return The minimum of the strips taken column by column.
+   */
+  Strip min(const Strip & rStrip1, const Strip & rStrip2);
+
+  /**
+   * Returns the strip with the columns <code>max(rStrip[i], rSlice)</code>.
+   * \param rStrip A strip of payoffs.
+   * \param rSlice A payoff.
+   * \return The maximum of \a rStrip and \a rSlice.
+   */
+  Strip max(const Strip & rStrip, const Slice & rSlice);
+
+  /**
+   * Returns the strip with the columns <code>min(rStrip[i], rSlice)</code>.
+   * \param rStrip A strip of payoffs.
+   * \param rSlice A payoff.
+   * \return The minimum of \a rStrip and \a rSlice.
+   */
+  Strip min(const Strip & rStrip, const Slice & rSlice);
+
+  /**
+   * Returns the strip with the columns <code>max(rSlice, rStrip[i])</code>.
+   * \param rSlice A payoff.
+   * \param rStrip A strip of payoffs.
+   * \return The maximum of \a rSlice and \a rStrip.
+   */
+  Strip max(const Slice & rSlice, const Strip & rStrip);
+
+  /**
+   * Returns the strip with the columns <code>min(rSlice, rStrip[i])</code>.
+   * \param rSlice A payoff.
+   * \param rStrip A strip of payoffs.
+   * \return The minimum of \a rSlice and \a rStrip.
+   */
+  Strip min(const Slice & rSlice, const Strip & rStrip);
+
+  /**
+   * Returns the strip with the columns <code>max(rStrip[i], dValue)</code>.
+   * \param rStrip A strip of payoffs.
+   * \param dValue A constant.
+   * \return The maximum of \a rStrip and \a dValue.
+   */
+  Strip max(const Strip & rStrip, double dValue);
+
+  /**
+   * Returns the strip with the columns <code>min(rStrip[i], dValue)</code>.
+   * \param rStrip A strip of payoffs.
+   * \param dValue A constant.
+   * \return The minimum of \a rStrip and \a dValue.
+   */
+  Strip min(const Strip & rStrip, double dValue);
+
+  /**
+   * Returns the strip with the columns <code>max(dValue, rStrip[i])</code>.
+   * \param dValue A constant.
+   * \param rStrip A strip of payoffs.
+   * \return The maximum of \a dValue and \a rStrip.
+   */
+  Strip max(double dValue, const Strip & rStrip);
+
+  /**
+   * Returns the strip with the columns <code>min(dValue, rStrip[i])</code>.
+   * \param dValue A constant.
+   * \param rStrip A strip of payoffs.
+   * \return The minimum of \a dValue and \a rStrip.
+   */
+  Strip min(double dValue, const Strip & rStrip);
+
+  /**
+   * Returns the equivalent value of \a rStrip at the event time with
+   * index \a iEventTime.
+   * \param rStrip A strip of payoffs.
+   * \param iEventTime Index of the target event time.
+   * \return The strip at the event time with index \a iEventTime.
+   */
+  Strip rollback(const Strip & rStrip, unsigned iEventTime);
+
+  /**
+   * Interpolates the columns of \a rStrip.
+   * \param rStrip A strip of payoffs.
+   * \return The vector of functions, one for every column.
+   * \see interpolate(const Slice &)
+   */
+  std::vector<MultiFunction> interpolate(const Strip & rStrip);
+
+  /**
+   * Returns the values of the columns of \a rStrip at the initial
+   * values of the state processes.
+   * \param rStrip A strip of payoffs.
+   * \return The values of the columns at the origin.
+   * \see atOrigin(const Slice &)
+   */
+  std::vector<double> atOrigin(const Strip & rStrip);
+  //@}
+}
+
+#include "cfl/Inline/iStrip.hpp"
+#endif // of __cflStrip_hpp__
@@ -4,6 +4,7 @@
 
 #include <functional>
 #include <algorithm>
+#include <vector>
 #include "cfl/Data.hpp"
 #include "test/Data.hpp"
 #include "test/Output.hpp"
@@ -29,9 +30,13 @@ void cfl::test::Data::print(const cfl::Function & rData, double dStartTime,
   double dPeriod = dInterval/iSize;
   std::cout << "time" << "    " << "value" << endl;
 
+  std::vector<double> uTimes(iSize), uValues(iSize);
   for (iI=0; iI<iSize; iI++) {
-    double dTime = dStartTime + iI*dPeriod;
-    std::cout << dTime << "   " << rData(dTime) << endl;
+    uTimes[iI] = dStartTime + iI*dPeriod;
+  }
+  rData.evaluate(uTimes.data(), uValues.data(), iSize);
+  for (iI=0; iI<iSize; iI++) {
+    std::cout << uTimes[iI] << "   " << uValues[iI] << endl;
   }
   pause();
 }